@@ -15,3 +15,18 @@
     #define ENABLE_VANILLA_LEVEL_SPECIFIC_CHECKS
     #define TEST_LEVEL LEVEL_CASTLE_GROUNDS
 #endif
+
+/**
+ * Enables the input replay recorder, which saves player 1's inputs and the RNG seed from a level load onwards,
+ * so that the same run can be played back later as a repeatable benchmark.
+ * Hold L and press D-pad Left to start/stop recording, D-pad Right to play back the recording,
+ * or D-pad Down to play it back headless (without waiting for vsync or running the RCP).
+ * Recording and playback both begin on the next level load, and playback must start in the level it was recorded in.
+ * The per-phase profiler totals are written to the Puppyprint log when playback ends.
+ */
+// #define INPUT_REPLAY
+
+/**
+ * The maximum number of input runs a recording can hold. A run is a span of frames with identical inputs, up to 255 frames long.
+ */
+#define INPUT_REPLAY_BUFFER_SIZE 4096
@@ -10,6 +10,43 @@
  */
 #define FAST_FLOOR_ALIGN 10
 
+/**
+ * Objects with OBJ_FLAG_FLOOR_CACHE set remember the last static floor they found, and only walk the whole cell again
+ * once they leave that triangle, change cells, or rise high enough to reach a static floor above it.
+ * Dynamic floors are still checked on every call.
+ */
+#define OBJECT_FLOOR_CACHE
+
+/**
+ * Sweeps Mario's wall checks along his whole movement each frame before stepping. If no wall is in the way, the movement
+ * is done in a single step instead of four quarter steps. Otherwise it's split into at least four steps, and as many more
+ * at high speeds as it takes for no step to be longer than the wall radius, which stops Mario from clipping through walls
+ * at any speed. This changes movement slightly, as floors are also only checked once per step, and very high speeds
+ * near walls cost a step per wall radius travelled.
+ */
+// #define SWEPT_WALL_COLLISION
+
+/**
+ * Keeps the dynamic surfaces of objects that haven't moved since the last frame loaded, instead of clearing and
+ * reloading every object's collision every frame. Only objects that moved, rotated, or scaled get re-transformed.
+ * Up to DYNAMIC_SURFACE_OBJECT_SLOTS objects can be tracked at once, any more are reloaded every frame as usual.
+ */
+#define INCREMENTAL_DYNAMIC_SURFACES
+#define DYNAMIC_SURFACE_OBJECT_SLOTS 32
+
+/**
+ * Builds a bounding volume hierarchy over the static surfaces of each area when it loads, which find_surface_on_ray
+ * (used by Puppycam's collision) walks instead of testing every surface in each cell the ray passes through.
+ * Costs up to around 20 bytes of main pool per static surface.
+ */
+// #define STATIC_SURFACE_BVH
+
+/**
+ * Puts objects into a grid each frame before checking which ones are touching, so each object is only checked against
+ * objects near it instead of every object in the lists it checks. Objects are still checked in the same order.
+ */
+#define OBJECT_COLLISION_BROADPHASE
+
 /**
  * Automatically calculates the optimal collision distance for an object based on its vertices.
  */
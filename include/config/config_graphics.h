@@ -9,6 +9,15 @@
  */
 #define GFX_POOL_SIZE 10000
 
+/**
+ * How much of the GFX pool (in Gfx commands) is kept free for the HUD, text and menus that are drawn after the level.
+ * Whatever part of the level's display lists and matrices doesn't fit in the rest of the pool is dropped for that frame
+ * instead of overflowing it, including what shadows, environment effects, paintings and the skybox build.
+ * The camera, projection and lighting set up once per frame also come out of the reserve, so keep it at least a few hundred.
+ * The Puppyprint RAM page shows how much each part of the game uses, to help size both of these.
+ */
+#define GFX_POOL_RESERVE 1000
+
 /**
  * Causes the global light direction to be in world space,
  * this allows you to have a singular light source that doesn't change with the camera's rotation.
@@ -151,3 +160,33 @@
  * Only use this if you can test the difference of your hack with and without this change on console.
  */
 // #define USE_FRUSTRATIO2
+
+/**
+ * Sorts the display lists of each z-buffered opaque and alpha layer by the model they belong to before drawing them,
+ * so that objects sharing a model are drawn back to back, and skips reloading the matrix between neighbouring
+ * display lists of the same object that share one.
+ * Display lists that aren't part of an object keep their order, as do the decal and transparent layers.
+ */
+#define SORT_MASTER_LIST_LAYERS
+
+/**
+ * Hands each frame's Gfx task to the scheduler as soon as it's built, queued behind the one the RCP is still working on,
+ * and only waits for that previous task right before its framebuffer is shown. The RCP then starts on the next frame
+ * the moment it finishes the last one, and the wait for it overlaps the vblank wait instead of adding to it.
+ * The time the game thread spends blocked on the RCP is shown as "RCP wait" on the Puppyprint profiler.
+ */
+#define GFX_TASK_PIPELINING
+
+/**
+ * Keeps the animation poses decoded while drawing objects in a small cache, keyed by animation and frame. Objects on the
+ * same frame of the same animation, and objects whose animation didn't advance since they were last drawn, read their
+ * bones' values from it instead of decoding them from the animation data again.
+ */
+#define ANIMATION_POSE_CACHE
+
+/**
+ * Blends each bone between the current and next animation frame by how far the animation has advanced between them,
+ * so animations played slower than normal (with an acceleration below 1x) move smoothly instead of holding each frame.
+ * Both frames come from the pose cache, so this needs ANIMATION_POSE_CACHE.
+ */
+// #define ANIMATION_FRAME_INTERPOLATION
@@ -1,5 +1,37 @@
 #pragma once
 
+/***************************
+ * GENERAL OBJECT SETTINGS *
+ ***************************/
+
+/**
+ * Objects with OBJ_FLAG_TICK_LOD set only run their behavior every 2nd, 4th or 8th frame once they're far enough
+ * from Mario, and any object can put itself to sleep with cur_obj_sleep until Mario comes close or it gets interacted with.
+ * Piranha Plants do this while they're idle and out of sight.
+ * Behaviors can read o->tickDelta to find out how many frames have passed since they last ran.
+ * Yellow coins spawned from macro and special object lists also wait until Mario is within their drawing distance
+ * before running their behavior for the first time, instead of all initialising on the first frame of the area.
+ */
+#define OBJECT_TICK_LOD
+
+/**
+ * The distances from Mario past which objects with OBJ_FLAG_TICK_LOD run every 2nd, 4th and 8th frame.
+ */
+#define OBJECT_TICK_LOD_DIST_2 3000.0f
+#define OBJECT_TICK_LOD_DIST_4 5000.0f
+#define OBJECT_TICK_LOD_DIST_8 8000.0f
+
+/**
+ * How close Mario has to get to a sleeping object to wake it up.
+ */
+#define OBJECT_SLEEP_WAKE_DIST 2000.0f
+
+/**
+ * Objects remember their distance, lateral distance and angle to Mario, so that behaviors asking for them again
+ * before either of them moves don't have to recompute them.
+ */
+#define MARIO_RELATIVE_CACHE
+
 /****************************
  * SPECIFIC OBJECT SETTINGS *
  ****************************/
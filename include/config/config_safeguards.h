@@ -68,6 +68,10 @@
     #define F3DLX2_REJ_GBI
 #endif // OBJECTS_REJ
 
+#ifndef ANIMATION_POSE_CACHE
+    #undef ANIMATION_FRAME_INTERPOLATION // Interpolation reads both frames from the pose cache.
+#endif // !ANIMATION_POSE_CACHE
+
 
 /*****************
  * config_debug.h
@@ -58,6 +58,7 @@ enum GeoLayoutCommands {
     /*0x1E*/ GEO_CMD_NOP_1E,
     /*0x1F*/ GEO_CMD_NOP_1F,
     /*0x20*/ GEO_CMD_NODE_CULLING_RADIUS,
+    /*0x21*/ GEO_CMD_NODE_INSTANCED_DISPLAY_LIST,
 };
 
 // geo layout macros
@@ -188,7 +189,7 @@ enum GeoLayoutCommands {
 
 /**
  * 0x0E: Create switch-case scene graph node
- *   0x01: unused
+ *   0x01: u8 parameter
  *   0x02: s16 numCases
  *   0x04: GraphNodeFunc caseSelectorFunc
  */
@@ -196,6 +197,19 @@ enum GeoLayoutCommands {
     CMD_BBH(GEO_CMD_NODE_SWITCH_CASE, 0x00, count), \
     CMD_PTR(function)
 
+/**
+ * Switch-case node that draws its first child only while the given room can be seen from Mario's room or the camera's,
+ * according to the area's ROOM_VISIBILITY table. Its second child is drawn otherwise, so it should be empty:
+ *   GEO_SWITCH_ROOM(room),
+ *   GEO_OPEN_NODE(),
+ *      GEO_DISPLAY_LIST(LAYER_OPAQUE, room_dl),
+ *      GEO_NODE_START(),
+ *   GEO_CLOSE_NODE(),
+ */
+#define GEO_SWITCH_ROOM(room) \
+    CMD_BBH(GEO_CMD_NODE_SWITCH_CASE, room, 2), \
+    CMD_PTR(geo_switch_room_visible)
+
 /**
  * 0x0F: Create a camera scene graph node.
  *   0x01: unused
@@ -467,4 +481,21 @@ enum GeoLayoutCommands {
 #define GEO_CULLING_RADIUS(cullingRadius) \
     CMD_BBH(GEO_CMD_NODE_CULLING_RADIUS, 0x00, cullingRadius)
 
+/**
+ * 0x21: Create an instanced display list scene graph node.
+ * Every object using this node in a frame gets drawn together: the material list once,
+ * the geometry list once per object, then the revert list. The geometry list must not change
+ * any of the state the material list sets up (Fast64's separate material, triangle and revert lists fit this).
+ *   0x01: u8 drawingLayer
+ *   0x02-0x03: unused
+ *   0x04: u32 materialList: display list segmented address, can be NULL
+ *   0x08: u32 geometryList: display list segmented address
+ *   0x0C: u32 revertList: display list segmented address, can be NULL
+ */
+#define GEO_INSTANCED_DISPLAY_LIST(layer, materialList, geometryList, revertList) \
+    CMD_BBH(GEO_CMD_NODE_INSTANCED_DISPLAY_LIST, layer, 0x0000), \
+    CMD_PTR(materialList), \
+    CMD_PTR(geometryList), \
+    CMD_PTR(revertList)
+
 #endif // GEO_COMMANDS_H
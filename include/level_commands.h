@@ -74,6 +74,7 @@ enum LevelCommands {
     /*0x3F*/ LEVEL_CMD_PUPPYLIGHT_ENVIRONMENT,
     /*0x40*/ LEVEL_CMD_PUPPYLIGHT_NODE,
     /*0x41*/ LEVEL_CMD_SET_ECHO,
+    /*0x42*/ LEVEL_CMD_SET_ROOM_VISIBILITY,
 };
 
 enum LevelActs {
@@ -402,6 +403,12 @@ enum GoddardScene {
     CMD_BBH(LEVEL_CMD_SET_ROOMS, 0x08, 0x0000), \
     CMD_PTR(surfaceRooms)
 
+// Table of which rooms can be seen from each room, generated by tools/room_pvs.py.
+// Entry 0 holds the number of entries, and entry N is a RoomVisibility bitfield of the rooms visible from room N.
+#define ROOM_VISIBILITY(roomVisibility) \
+    CMD_BBH(LEVEL_CMD_SET_ROOM_VISIBILITY, 0x08, 0x0000), \
+    CMD_PTR(roomVisibility)
+
 #define SHOW_DIALOG(index, dialogId) \
     CMD_BBBB(LEVEL_CMD_SHOW_DIALOG, 0x04, index, dialogId)
 
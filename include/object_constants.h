@@ -18,6 +18,8 @@ enum ObjActiveFlags {
     ACTIVE_FLAG_ALLOCATED                      = (1 <<  8), // 0x0100
     ACTIVE_FLAG_DESTRUCTIVE_OBJ_DONT_DESTROY   = (1 <<  9), // 0x0200
     ACTIVE_FLAG_IGNORE_ENV_BOXES               = (1 << 10), // 0x0400
+    ACTIVE_FLAG_SLEEPING                       = (1 << 11), // 0x0800
+    ACTIVE_FLAG_DEFERRED_INIT                  = (1 << 12), // 0x1000
 };
 
 /* respawnInfoType */
@@ -56,6 +58,8 @@ enum ObjFlags {
     OBJ_FLAG_OPACITY_FROM_CAMERA_DIST          = (1 << 21), // 0x00200000
     OBJ_FLAG_EMIT_LIGHT                        = (1 << 22), // 0x00400000
     OBJ_FLAG_ONLY_PROCESS_INSIDE_ROOM          = (1 << 23), // 0x00800000
+    OBJ_FLAG_FLOOR_CACHE                       = (1 << 24), // 0x01000000
+    OBJ_FLAG_TICK_LOD                          = (1 << 25), // 0x02000000
     OBJ_FLAG_HITBOX_WAS_SET                    = (1 << 30), // 0x40000000
 };
 
@@ -99,6 +99,8 @@ typedef s16 ColFlags;
 
 // -- Collision --
 typedef ROOM_DATA_TYPE RoomData;
+// Bit N is set if room N can be seen from a room. See ROOM_VISIBILITY in level_commands.h.
+typedef u64 RoomVisibility;
 typedef COLLISION_DATA_TYPE Collision; // Collision is by default an s16, but it's best to have it match the type of COLLISION_DATA_TYPE
 typedef Collision TerrainData;
 typedef Collision Vec3t[3];
@@ -272,6 +274,32 @@ struct PuppyLight {
 };
 #endif
 
+#ifdef OBJECT_FLOOR_CACHE
+struct FloorCache {
+    struct Surface *floor; // The last static floor found, or NULL if there isn't one cached.
+    f32 maxY;              // The lowest point at which an overlapping static floor above this one starts.
+    s16 cellX, cellZ;      // The cell the floor was found in.
+    u16 loadCount;         // gStaticSurfaceLoadCount at the time the floor was found.
+};
+#endif
+
+#ifdef MARIO_RELATIVE_CACHE
+enum MarioRelativeCacheFlags {
+    MARIO_CACHE_DIST         = (1 << 0),
+    MARIO_CACHE_LATERAL_DIST = (1 << 1),
+    MARIO_CACHE_ANGLE        = (1 << 2),
+};
+
+struct MarioRelativeCache {
+    Vec3f objPos;     // The object's position when the values were computed.
+    Vec3f marioPos;   // Mario's position when the values were computed.
+    f32 dist;
+    f32 lateralDist;
+    s16 angle;        // Angle from the object to Mario.
+    u8 validFlags;    // MarioRelativeCacheFlags of the values that have been computed.
+};
+#endif
+
 // NOTE: Since ObjectNode is the first member of Object, it is difficult to determine
 // whether some of these pointers point to ObjectNode or Object.
 
@@ -341,6 +369,18 @@ struct Object {
 #ifdef PUPPYLIGHTS
     struct PuppyLight puppylight;
 #endif
+#ifdef OBJECT_FLOOR_CACHE
+    struct FloorCache floorCache;
+#endif
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    u8 dynamicSurfaceSlot; // Index into the table used to track whether this object's collision has moved.
+#endif
+#ifdef OBJECT_TICK_LOD
+    u8 tickDelta; // Frames since this object's behavior last ran, so 1 when it runs every frame.
+#endif
+#ifdef MARIO_RELATIVE_CACHE
+    struct MarioRelativeCache marioRelativeCache;
+#endif
 };
 
 struct ObjectHitbox {
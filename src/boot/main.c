@@ -294,15 +294,6 @@ void handle_sp_complete(void) {
     }
 }
 
-void handle_dp_complete(void) {
-    // Gfx SP task is completely done.
-    if (sCurrentDisplaySPTask->msgqueue != NULL) {
-        osSendMesg(sCurrentDisplaySPTask->msgqueue, sCurrentDisplaySPTask->msg, OS_MESG_NOBLOCK);
-    }
-    sCurrentDisplaySPTask->state = SPTASK_STATE_FINISHED_DP;
-    sCurrentDisplaySPTask = NULL;
-}
-
 OSTimerEx RCPHangTimer;
 void start_rcp_hang_timer(void) {
     if (RCPHangTimer.started == FALSE) {
@@ -316,6 +307,23 @@ void stop_rcp_hang_timer(void) {
     RCPHangTimer.started = FALSE;
 }
 
+void handle_dp_complete(void) {
+    // Gfx SP task is completely done.
+    if (sCurrentDisplaySPTask->msgqueue != NULL) {
+        osSendMesg(sCurrentDisplaySPTask->msgqueue, sCurrentDisplaySPTask->msg, OS_MESG_NOBLOCK);
+    }
+    sCurrentDisplaySPTask->state = SPTASK_STATE_FINISHED_DP;
+    sCurrentDisplaySPTask = NULL;
+
+    // A frame that was queued behind this one can start right away, instead of waiting for the next vblank.
+    if (sNextDisplaySPTask != NULL) {
+        sCurrentDisplaySPTask = sNextDisplaySPTask;
+        sNextDisplaySPTask = NULL;
+        start_rcp_hang_timer();
+        start_gfx_sptask();
+    }
+}
+
 void alert_rcp_hung_up(void) {
     error("RCP is HUNG UP!! Oh! MY GOD!!");
 }
@@ -422,6 +430,7 @@ void thread3_main(UNUSED void *arg) {
                 handle_dp_complete();
                 break;
             case MESG_START_GFX_SPTASK:
+                receive_new_tasks();
                 start_rcp_hang_timer();
                 start_gfx_sptask();
                 break;
@@ -468,13 +477,10 @@ void exec_display_list(struct SPTask *spTask) {
     if (spTask != NULL) {
         osWritebackDCacheAll();
         spTask->state = SPTASK_STATE_NOT_STARTED;
-        if (sCurrentDisplaySPTask == NULL) {
-            sCurrentDisplaySPTask = spTask;
-            sNextDisplaySPTask = NULL;
-            osSendMesg(&gIntrMesgQueue, (OSMesg) MESG_START_GFX_SPTASK, OS_MESG_NOBLOCK);
-        } else {
-            sNextDisplaySPTask = spTask;
-        }
+        // The scheduler owns the current and next display tasks, so the task is queued for it to pick up
+        // rather than written into them from this thread.
+        osSendMesg(&gSPTaskMesgQueue, spTask, OS_MESG_NOBLOCK);
+        osSendMesg(&gIntrMesgQueue, (OSMesg) MESG_START_GFX_SPTASK, OS_MESG_NOBLOCK);
     }
 }
 
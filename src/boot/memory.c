@@ -595,6 +595,19 @@ void *alloc_display_list(u32 size) {
     return ptr;
 }
 
+/**
+ * Allocates from the Gfx pool like alloc_display_list, for the display lists and matrices built while walking the level's
+ * graph. Returns NULL instead if that would leave less than GFX_POOL_RESERVE free for what's drawn after the level.
+ */
+void *alloc_level_display_list(u32 size) {
+    if ((gGfxPoolEnd - (u8 *) gDisplayListHead) < (s32) (ALIGN8(size) + (GFX_POOL_RESERVE * sizeof(Gfx)))) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.gfx_dropped_lists);
+        return NULL;
+    }
+
+    return alloc_display_list(size);
+}
+
 static struct DmaTable *load_dma_table_address(u8 *srcAddr) {
     struct DmaTable *table = dynamic_dma_read(srcAddr, srcAddr + sizeof(u32),
                                                              MEMORY_POOL_LEFT, 0, 0);
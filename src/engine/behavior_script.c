@@ -1,6 +1,7 @@
 #include <ultra64.h>
 
 #include "sm64.h"
+#include "behavior_commands.h"
 #include "behavior_data.h"
 #include "behavior_script.h"
 #include "game/area.h"
@@ -854,10 +855,27 @@ void cur_obj_update(void) {
     // Execute the behavior script.
     gCurBhvCommand = o->curBhvCommand;
 
-    do {
-        bhvCmdProc = BehaviorCmdTable[*gCurBhvCommand >> 24];
-        bhvProcResult = bhvCmdProc();
-    } while (bhvProcResult == BHV_PROC_CONTINUE);
+    // Most scripts settle into a BEGIN_LOOP of nothing but CALL_NATIVE commands, so those and END_LOOP are
+    // run inline here instead of going through the command table. Everything else is left to the table.
+    while (TRUE) {
+        u32 cmd = (*gCurBhvCommand >> 24);
+
+        if (cmd == BHV_CMD_CALL_NATIVE) {
+            NativeBhvFunc behaviorFunc = BHV_CMD_GET_VPTR(1);
+            behaviorFunc();
+            gCurBhvCommand += 2;
+        } else if (cmd == BHV_CMD_END_LOOP) {
+            // Same as bhv_cmd_end_loop, which pops the loop start and then pushes it straight back.
+            gCurBhvCommand = (const BehaviorScript *) o->bhvStack[o->bhvStackIndex - 1];
+            break;
+        } else {
+            bhvCmdProc = BehaviorCmdTable[cmd];
+            bhvProcResult = bhvCmdProc();
+            if (bhvProcResult != BHV_PROC_CONTINUE) {
+                break;
+            }
+        }
+    }
 
     o->curBhvCommand = gCurBhvCommand;
 
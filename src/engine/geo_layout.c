@@ -42,6 +42,7 @@ GeoLayoutCommandProc GeoLayoutJumpTable[] = {
     /*GEO_CMD_NOP_1E                    */ geo_layout_cmd_nop2,
     /*GEO_CMD_NOP_1F                    */ geo_layout_cmd_nop3,
     /*GEO_CMD_NODE_CULLING_RADIUS       */ geo_layout_cmd_node_culling_radius,
+    /*GEO_CMD_NODE_INSTANCED_DISPLAY_LIST*/ geo_layout_cmd_node_instanced_display_list,
 };
 
 struct GraphNode gObjParentGraphNode;
@@ -317,6 +318,7 @@ void geo_layout_cmd_node_level_of_detail(void) {
 
 /*
   0x0E: Create switch-case scene graph node
+   cmd+0x01: u8 parameter (passed to caseSelectorFunc through the node, like the room of GEO_SWITCH_ROOM)
    cmd+0x02: s16 initialSelectedCase
    cmd+0x04: GraphNodeFunc caseSelectorFunc
 
@@ -329,7 +331,7 @@ void geo_layout_cmd_node_switch_case(void) {
                                     cur_geo_cmd_s16(0x02), // case which is initially selected
                                     0,
                                     (GraphNodeFunc) cur_geo_cmd_ptr(0x04), // case update function
-                                    0);
+                                    cur_geo_cmd_u8(0x01)); // parameter
 
     register_scene_graph_node(&graphNode->fnNode.node);
 
@@ -440,6 +442,7 @@ void geo_layout_cmd_node_translation_rotation(void) {
     graphNode = init_graph_node_translation_rotation(gGraphNodePool, NULL, drawingLayer, displayList,
                                                      translation, rotation);
     register_scene_graph_node(&graphNode->node);
+    graphNode->matrixCache = geo_alloc_matrix_cache(gGraphNodePool, &graphNode->node);
 
     gGeoLayoutCommand = (u8 *) cmdPos;
 }
@@ -476,6 +479,7 @@ void geo_layout_cmd_node_translation(void) {
         init_graph_node_translation(gGraphNodePool, NULL, drawingLayer, displayList, translation);
 
     register_scene_graph_node(&graphNode->node);
+    graphNode->matrixCache = geo_alloc_matrix_cache(gGraphNodePool, &graphNode->node);
 
     gGeoLayoutCommand = (u8 *) cmdPos;
 }
@@ -511,6 +515,7 @@ void geo_layout_cmd_node_rotation(void) {
     graphNode = init_graph_node_rotation(gGraphNodePool, NULL, drawingLayer, displayList, angle);
 
     register_scene_graph_node(&graphNode->node);
+    graphNode->matrixCache = geo_alloc_matrix_cache(gGraphNodePool, &graphNode->node);
 
     gGeoLayoutCommand = (u8 *) cmdPos;
 }
@@ -540,6 +545,7 @@ void geo_layout_cmd_node_scale(void) {
     graphNode = init_graph_node_scale(gGraphNodePool, NULL, drawingLayer, displayList, scale);
 
     register_scene_graph_node(&graphNode->node);
+    graphNode->matrixCache = geo_alloc_matrix_cache(gGraphNodePool, &graphNode->node);
 
     gGeoLayoutCommand += 0x08 << CMD_SIZE_SHIFT;
 }
@@ -750,6 +756,27 @@ void geo_layout_cmd_node_culling_radius(void) {
     gGeoLayoutCommand += 0x04 << CMD_SIZE_SHIFT;
 }
 
+/*
+  0x21: Create instanced display list scene graph node
+   cmd+0x01: u8 drawingLayer
+   cmd+0x04: void *materialList
+   cmd+0x08: void *geometryList
+   cmd+0x0C: void *revertList
+*/
+void geo_layout_cmd_node_instanced_display_list(void) {
+    struct GraphNodeInstancedDisplayList *graphNode;
+    s32 drawingLayer = cur_geo_cmd_u8(0x01);
+    void *materialList = cur_geo_cmd_ptr(0x04);
+    void *geometryList = cur_geo_cmd_ptr(0x08);
+    void *revertList = cur_geo_cmd_ptr(0x0C);
+
+    graphNode = init_graph_node_instanced_display_list(gGraphNodePool, NULL, drawingLayer, materialList, geometryList, revertList);
+
+    register_scene_graph_node(&graphNode->node);
+
+    gGeoLayoutCommand += 0x10 << CMD_SIZE_SHIFT;
+}
+
 struct GraphNode *process_geo_layout(struct AllocOnlyPool *pool, void *segptr) {
     // set by register_scene_graph_node when gCurGraphNodeIndex is 0
     // and gCurRootGraphNode is NULL
@@ -153,7 +153,7 @@ struct GraphNodeLevelOfDetail *init_graph_node_render_range(struct AllocOnlyPool
 struct GraphNodeSwitchCase *init_graph_node_switch_case(struct AllocOnlyPool *pool,
                                                         struct GraphNodeSwitchCase *graphNode,
                                                         s16 numCases, s16 selectedCase,
-                                                        GraphNodeFunc nodeFunc, s32 unused) {
+                                                        GraphNodeFunc nodeFunc, s32 parameter) {
     if (pool != NULL) {
         graphNode = alloc_only_pool_alloc(pool, sizeof(struct GraphNodeSwitchCase));
     }
@@ -163,7 +163,7 @@ struct GraphNodeSwitchCase *init_graph_node_switch_case(struct AllocOnlyPool *po
         graphNode->numCases = numCases;
         graphNode->selectedCase = selectedCase;
         graphNode->fnNode.func = nodeFunc;
-        graphNode->unused = unused;
+        graphNode->parameter = parameter;
 
         if (nodeFunc != NULL) {
             nodeFunc(GEO_CONTEXT_CREATE, &graphNode->fnNode.node, pool);
@@ -218,11 +218,46 @@ init_graph_node_translation_rotation(struct AllocOnlyPool *pool,
         vec3s_copy(graphNode->rotation, rotation);
         SET_GRAPH_NODE_LAYER(graphNode->node.flags, drawingLayer);
         graphNode->displayList = displayList;
+        graphNode->matrixCache = NULL;
     }
 
     return graphNode;
 }
 
+/**
+ * Allocates a matrix cache for a transform node that was just added to the graph, if its matrix only
+ * depends on its own parameters and those of other transform nodes. That's the case for level geometry
+ * below a camera node, but not for anything that's part of an object's model, since that's shared
+ * between objects and moves with them.
+ */
+struct GraphNodeMatrixCache *geo_alloc_matrix_cache(struct AllocOnlyPool *pool, struct GraphNode *graphNode) {
+    struct GraphNode *parent;
+    struct GraphNodeMatrixCache *cache;
+
+    for (parent = graphNode->parent; parent != NULL; parent = parent->parent) {
+        switch (parent->type) {
+            case GRAPH_NODE_TYPE_CAMERA:
+                // The Mtx needs to be 8 byte aligned for the RSP.
+                cache = alloc_only_pool_alloc(pool, sizeof(struct GraphNodeMatrixCache) + 4);
+                if (cache != NULL) {
+                    cache = (struct GraphNodeMatrixCache *) ALIGN8((uintptr_t) cache);
+                    cache->stamp = 0;
+                    cache->parentStamp = 0;
+                    cache->fixedMatrixValid = FALSE;
+                }
+                return cache;
+            case GRAPH_NODE_TYPE_OBJECT:
+            case GRAPH_NODE_TYPE_OBJECT_PARENT:
+            case GRAPH_NODE_TYPE_ANIMATED_PART:
+            case GRAPH_NODE_TYPE_BILLBOARD:
+            case GRAPH_NODE_TYPE_HELD_OBJ:
+                return NULL;
+        }
+    }
+
+    return NULL;
+}
+
 /**
  * Allocates and returns a newly created translation node
  */
@@ -240,6 +275,7 @@ struct GraphNodeTranslation *init_graph_node_translation(struct AllocOnlyPool *p
         vec3s_copy(graphNode->translation, translation);
         SET_GRAPH_NODE_LAYER(graphNode->node.flags, drawingLayer);
         graphNode->displayList = displayList;
+        graphNode->matrixCache = NULL;
     }
 
     return graphNode;
@@ -261,6 +297,7 @@ struct GraphNodeRotation *init_graph_node_rotation(struct AllocOnlyPool *pool,
         vec3s_copy(graphNode->rotation, rotation);
         SET_GRAPH_NODE_LAYER(graphNode->node.flags, drawingLayer);
         graphNode->displayList = displayList;
+        graphNode->matrixCache = NULL;
     }
 
     return graphNode;
@@ -281,6 +318,7 @@ struct GraphNodeScale *init_graph_node_scale(struct AllocOnlyPool *pool,
         SET_GRAPH_NODE_LAYER(graphNode->node.flags, drawingLayer);
         graphNode->scale = scale;
         graphNode->displayList = displayList;
+        graphNode->matrixCache = NULL;
     }
 
     return graphNode;
@@ -395,6 +433,34 @@ struct GraphNodeDisplayList *init_graph_node_display_list(struct AllocOnlyPool *
     return graphNode;
 }
 
+/**
+ * Allocates and returns a newly created instanced display list node
+ */
+struct GraphNodeInstancedDisplayList *init_graph_node_instanced_display_list(struct AllocOnlyPool *pool,
+                                                                            struct GraphNodeInstancedDisplayList *graphNode,
+                                                                            s32 drawingLayer, void *materialList,
+                                                                            void *geometryList, void *revertList) {
+    if (pool != NULL) {
+        graphNode = alloc_only_pool_alloc(pool, sizeof(struct GraphNodeInstancedDisplayList));
+    }
+
+    if (graphNode != NULL) {
+        init_scene_graph_node_links(&graphNode->node, GRAPH_NODE_TYPE_INSTANCED_DISPLAY_LIST);
+        SET_GRAPH_NODE_LAYER(graphNode->node.flags, drawingLayer);
+        graphNode->materialList = materialList;
+        graphNode->geometryList = geometryList;
+        graphNode->revertList = revertList;
+        graphNode->instanceHead = NULL;
+        graphNode->instanceTail = NULL;
+        graphNode->nextBatch = NULL;
+        graphNode->batchCounter = 0;
+        graphNode->batchLayer = drawingLayer;
+        graphNode->batchUcode = 0;
+    }
+
+    return graphNode;
+}
+
 /**
  * Allocates and returns a newly created shadow node
  */
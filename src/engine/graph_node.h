@@ -72,6 +72,7 @@ enum GraphNodeTypes {
     GRAPH_NODE_TYPE_BACKGROUND,
     GRAPH_NODE_TYPE_HELD_OBJ,
     GRAPH_NODE_TYPE_CULLING_RADIUS,
+    GRAPH_NODE_TYPE_INSTANCED_DISPLAY_LIST,
     GRAPH_NODE_TYPE_ROOT,
     GRAPH_NODE_TYPE_START,
 };
@@ -147,6 +148,9 @@ struct DisplayListNode {
     Mtx *transform;
     void *displayList;
     struct DisplayListNode *next;
+#ifdef SORT_MASTER_LIST_LAYERS
+    uintptr_t sortKey; // The object's model, or 0 if the display list isn't part of an object.
+#endif
 };
 
 /** GraphNode that manages the 8 top-level display lists that will be drawn
@@ -158,6 +162,8 @@ struct GraphNodeMasterList {
     /*0x00*/ struct GraphNode node;
     /*0x14*/ struct DisplayListNode *listHeads[GRAPH_NODE_NUM_UCODES][LAYER_COUNT];
     /*0x34*/ struct DisplayListNode *listTails[GRAPH_NODE_NUM_UCODES][LAYER_COUNT];
+    // Instanced display list nodes that were reached this frame, drawn after the rest of their layer.
+    struct GraphNodeInstancedDisplayList *instanceBatches[GRAPH_NODE_NUM_UCODES][LAYER_COUNT];
 };
 
 /** Simply used as a parent to group multiple children.
@@ -186,7 +192,7 @@ struct GraphNodeLevelOfDetail {
  */
 struct GraphNodeSwitchCase {
     /*0x00*/ struct FnGraphNode fnNode;
-    /*0x18*/ s32 unused;
+    /*0x18*/ s32 parameter; // Extra value for the node's function, set by the geo command.
     /*0x1C*/ s16 numCases;
     /*0x1E*/ s16 selectedCase;
 };
@@ -212,6 +218,21 @@ struct GraphNodeCamera {
     /*0x3A*/ s16 rollScreen; // rolls screen while keeping the light direction consistent
 };
 
+/** The matrix of a level geometry transform node from the last time it or its parents changed, so that
+ *  it doesn't need to be recomputed and reconverted every frame. Transform nodes only get one when
+ *  they're below a camera node and not part of an object (see geo_alloc_matrix_cache).
+ */
+struct GraphNodeMatrixCache {
+    /*0x00*/ Mtx fixedMatrix; // Only written once 'matrix' has gone a frame unchanged, as the RSP may still be reading it.
+    /*0x40*/ Mat4 matrix;
+    /*0x80*/ u32 stamp; // Changes whenever 'matrix' does.
+    /*0x84*/ u32 parentStamp; // The parent's stamp when 'matrix' was computed.
+    /*0x88*/ Vec3s translation;
+    /*0x8E*/ Vec3s rotation;
+    /*0x94*/ f32 scale;
+    /*0x98*/ u8 fixedMatrixValid;
+};
+
 /** GraphNode that translates and rotates its children.
  *  Usage example: wing cap wings.
  *  There is a dprint function that sets the translation and rotation values
@@ -223,6 +244,7 @@ struct GraphNodeTranslationRotation {
     /*0x14*/ void *displayList;
     /*0x18*/ Vec3s translation;
     /*0x1E*/ Vec3s rotation;
+    /*0x24*/ struct GraphNodeMatrixCache *matrixCache;
 };
 
 /** GraphNode that translates itself and its children.
@@ -234,6 +256,7 @@ struct GraphNodeTranslation {
     /*0x14*/ void *displayList;
     /*0x18*/ Vec3s translation;
     // u8 filler[2];
+    /*0x20*/ struct GraphNodeMatrixCache *matrixCache;
 };
 
 /** GraphNode that rotates itself and its children.
@@ -246,6 +269,7 @@ struct GraphNodeRotation {
     /*0x14*/ void *displayList;
     /*0x18*/ Vec3s rotation;
     // u8 filler[2];
+    /*0x20*/ struct GraphNodeMatrixCache *matrixCache;
 };
 
 /** GraphNode part that transforms itself and its children based on animation
@@ -280,6 +304,25 @@ struct GraphNodeDisplayList {
     /*0x14*/ void *displayList;
 };
 
+/** GraphNode that draws a model split into a material, geometry and revert display list.
+ *  Instead of going into the master list on its own each time it's reached, the current
+ *  transform is added to the node's instances. The master list then runs the material list
+ *  once, the geometry list once per instance, and the revert list once.
+ *  Used for models that appear many times at once, like coins.
+ */
+struct GraphNodeInstancedDisplayList {
+    /*0x00*/ struct GraphNode node;
+    /*0x14*/ void *materialList;
+    /*0x18*/ void *geometryList;
+    /*0x1C*/ void *revertList;
+    /*0x20*/ struct DisplayListNode *instanceHead;
+    /*0x24*/ struct DisplayListNode *instanceTail;
+    /*0x28*/ struct GraphNodeInstancedDisplayList *nextBatch;
+    /*0x2C*/ u32 batchCounter; // The master list pass the instances were gathered in.
+    /*0x30*/ u8 batchLayer;
+    /*0x31*/ u8 batchUcode;
+};
+
 /** GraphNode part that scales itself and its children.
  *  Usage example: Mario's fist or shoe, which grows when attacking. This can't
  *  be done with an animated part sine animation data doesn't support scaling.
@@ -292,6 +335,7 @@ struct GraphNodeScale {
     /*0x00*/ struct GraphNode node;
     /*0x14*/ void *displayList;
     /*0x18*/ f32 scale;
+    /*0x1C*/ struct GraphNodeMatrixCache *matrixCache;
 };
 
 /** GraphNode that draws a shadow under an object.
@@ -376,7 +420,7 @@ struct GraphNodePerspective         *init_graph_node_perspective         (struct
 struct GraphNodeStart               *init_graph_node_start               (struct AllocOnlyPool *pool, struct GraphNodeStart               *graphNode);
 struct GraphNodeMasterList          *init_graph_node_master_list         (struct AllocOnlyPool *pool, struct GraphNodeMasterList          *graphNode, s16 on);
 struct GraphNodeLevelOfDetail       *init_graph_node_render_range        (struct AllocOnlyPool *pool, struct GraphNodeLevelOfDetail       *graphNode, s16 minDistance, s16 maxDistance);
-struct GraphNodeSwitchCase          *init_graph_node_switch_case         (struct AllocOnlyPool *pool, struct GraphNodeSwitchCase          *graphNode, s16 numCases, s16 selectedCase, GraphNodeFunc nodeFunc, s32 unused);
+struct GraphNodeSwitchCase          *init_graph_node_switch_case         (struct AllocOnlyPool *pool, struct GraphNodeSwitchCase          *graphNode, s16 numCases, s16 selectedCase, GraphNodeFunc nodeFunc, s32 parameter);
 struct GraphNodeCamera              *init_graph_node_camera              (struct AllocOnlyPool *pool, struct GraphNodeCamera              *graphNode, f32 *pos, f32 *focus, GraphNodeFunc func, s32 mode);
 struct GraphNodeTranslationRotation *init_graph_node_translation_rotation(struct AllocOnlyPool *pool, struct GraphNodeTranslationRotation *graphNode, s32 drawingLayer, void *displayList, Vec3s translation, Vec3s rotation);
 struct GraphNodeTranslation         *init_graph_node_translation         (struct AllocOnlyPool *pool, struct GraphNodeTranslation         *graphNode, s32 drawingLayer, void *displayList, Vec3s translation);
@@ -387,6 +431,8 @@ struct GraphNodeCullingRadius       *init_graph_node_culling_radius      (struct
 struct GraphNodeAnimatedPart        *init_graph_node_animated_part       (struct AllocOnlyPool *pool, struct GraphNodeAnimatedPart        *graphNode, s32 drawingLayer, void *displayList, Vec3s translation);
 struct GraphNodeBillboard           *init_graph_node_billboard           (struct AllocOnlyPool *pool, struct GraphNodeBillboard           *graphNode, s32 drawingLayer, void *displayList, Vec3s translation);
 struct GraphNodeDisplayList         *init_graph_node_display_list        (struct AllocOnlyPool *pool, struct GraphNodeDisplayList         *graphNode, s32 drawingLayer, void *displayList);
+struct GraphNodeMatrixCache *geo_alloc_matrix_cache(struct AllocOnlyPool *pool, struct GraphNode *graphNode);
+struct GraphNodeInstancedDisplayList *init_graph_node_instanced_display_list(struct AllocOnlyPool *pool, struct GraphNodeInstancedDisplayList *graphNode, s32 drawingLayer, void *materialList, void *geometryList, void *revertList);
 struct GraphNodeShadow              *init_graph_node_shadow              (struct AllocOnlyPool *pool, struct GraphNodeShadow              *graphNode, s16 shadowScale, u8 shadowSolidity, u8 shadowType);
 struct GraphNodeObjectParent        *init_graph_node_object_parent       (struct AllocOnlyPool *pool, struct GraphNodeObjectParent        *graphNode, struct GraphNode *sharedChild);
 struct GraphNodeGenerated           *init_graph_node_generated           (struct AllocOnlyPool *pool, struct GraphNodeGenerated           *graphNode, GraphNodeFunc gfxFunc, s32 parameter);
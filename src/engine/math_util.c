@@ -6,6 +6,7 @@
 #include "surface_collision.h"
 #include "trig_tables.inc.c"
 #include "surface_load.h"
+#include "surface_bvh.h"
 #include "game/puppyprint.h"
 #include "game/rendering_graph_node.h"
 
@@ -53,6 +54,16 @@ u16 random_u16(void) {
     return gRandomSeed16;
 }
 
+// Get the current random seed, so that it can be restored later to repeat the same sequence.
+u16 random_get_seed(void) {
+    return gRandomSeed16;
+}
+
+// Set the random seed.
+void random_set_seed(u16 seed) {
+    gRandomSeed16 = seed;
+}
+
 // Generate a pseudorandom float in the range [0, 1).
 f32 random_float(void) {
     return ((f32) random_u16() / (f32) 0x10000);
@@ -1290,7 +1301,7 @@ s32 anim_spline_poll(Vec3f result) {
  */
 s32 ray_surface_intersect(Vec3f orig, Vec3f dir, f32 dir_length, struct Surface *surface, Vec3f hit_pos, f32 *length) {
     // Ignore certain surface types.
-    if ((surface->type == SURFACE_INTANGIBLE) || (surface->flags & SURFACE_FLAG_NO_CAM_COLLISION)) return FALSE;
+    if (IS_RAYCAST_IGNORED_SURFACE(surface)) return FALSE;
     // Convert the vertices to Vec3f.
     Vec3f v0, v1, v2;
     vec3s_to_vec3f(v0, surface->vertex1);
@@ -1372,26 +1383,21 @@ void find_surface_on_ray_list(struct SurfaceNode *list, Vec3f orig, Vec3f dir, f
     profiler_collision_update(first);
 }
 
+static void find_surface_on_ray_partition(SpatialPartitionCell *cell, Vec3f orig, Vec3f normalized_dir, f32 dir_length, struct Surface **hit_surface, Vec3f hit_pos, f32 *max_length, s32 flags) {
+    if (flags & RAYCAST_FIND_CEIL ) find_surface_on_ray_list((*cell)[SPATIAL_PARTITION_CEILS ].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+    if (flags & RAYCAST_FIND_FLOOR) find_surface_on_ray_list((*cell)[SPATIAL_PARTITION_FLOORS].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+    if (flags & RAYCAST_FIND_WALL ) find_surface_on_ray_list((*cell)[SPATIAL_PARTITION_WALLS ].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+    if (flags & RAYCAST_FIND_WATER) find_surface_on_ray_list((*cell)[SPATIAL_PARTITION_WATER ].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+}
+
 void find_surface_on_ray_cell(s32 cellX, s32 cellZ, Vec3f orig, Vec3f normalized_dir, f32 dir_length, struct Surface **hit_surface, Vec3f hit_pos, f32 *max_length, s32 flags) {
     // Skip if OOB
     if ((cellX >= 0) && (cellX <= (NUM_CELLS - 1)) && (cellZ >= 0) && (cellZ <= (NUM_CELLS - 1))) {
-        // Iterate through each surface in this partition
-        if ((normalized_dir[1] > -NEAR_ONE) && (flags & RAYCAST_FIND_CEIL)) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-            find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_CEILS ].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-        }
-        if ((normalized_dir[1] <  NEAR_ONE) && (flags & RAYCAST_FIND_FLOOR)) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-            find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-        }
-        if (flags & RAYCAST_FIND_WALL) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-            find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS ].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-        }
-        if (flags & RAYCAST_FIND_WATER) {
-            find_surface_on_ray_list( gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
-            find_surface_on_ray_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WATER ].next, orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length);
+        // Static surfaces are already covered by the BVH when there is one.
+        if (!surface_bvh_is_active()) {
+            find_surface_on_ray_partition(&gStaticSurfacePartition[cellZ][cellX], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length, flags);
         }
+        find_surface_on_ray_partition(&gDynamicSurfacePartition[cellZ][cellX], orig, normalized_dir, dir_length, hit_surface, hit_pos, max_length, flags);
     }
 }
 
@@ -1410,6 +1416,17 @@ f32 find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec
     vec3f_copy(normalized_dir, dir);
     vec3f_normalize(normalized_dir);
 
+    // A ray that's pointing straight up can't hit a ceiling, and one pointing straight down can't hit a floor.
+    if (normalized_dir[1] <= -NEAR_ONE) flags &= ~RAYCAST_FIND_CEIL;
+    if (normalized_dir[1] >=  NEAR_ONE) flags &= ~RAYCAST_FIND_FLOOR;
+
+#ifdef STATIC_SURFACE_BVH
+    if (surface_bvh_is_active()) {
+        find_surface_on_ray_bvh(orig, normalized_dir, dir_length, hit_surface, hit_pos, &max_length, flags);
+        find_surface_on_ray_partition(&gStaticSurfaceBVH.lateSurfaces, orig, normalized_dir, dir_length, hit_surface, hit_pos, &max_length, flags);
+    }
+#endif
+
     // Get the start and end coords converted to cell-space
     f32 start_cell_coord_x = (orig[0] + LEVEL_BOUNDARY_MAX) * invcell;
     f32 start_cell_coord_z = (orig[2] + LEVEL_BOUNDARY_MAX) * invcell;
@@ -1440,7 +1457,8 @@ f32 find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec
     while (TRUE) {
         find_surface_on_ray_cell((s32)p_x, (s32)p_z, orig, normalized_dir, dir_length, hit_surface, hit_pos, &max_length, flags);
         f32 t_next = MIN(t_max_x, t_max_z);
-        if (t_next > 1.0f) {
+        // Stop at the end of the ray, or once the next cell starts past the closest hit so far.
+        if ((t_next > 1.0f) || ((t_next * dir_length) > max_length)) {
             break;
         }
 
@@ -1495,42 +1513,41 @@ static ALWAYS_INLINE float construct_float(const float f)
     return f_out;
 }
 
+// Converts the element at 'index' of a floating point matrix to fixed point, and writes its
+// integer half to the first half of the fixed point matrix and its fractional half to the second.
+#define MTXF_TO_MTX_ELEMENT(dst, src, index, scale) {  \
+    s32 fixed = (s32)((src)[index] * (scale));          \
+    (dst)[(index) +  0] = (s16)(fixed >> 16);           \
+    (dst)[(index) + 16] = (s16)(fixed >>  0);           \
+}
+
 // Converts a floating point matrix to a fixed point matrix
 // Makes some assumptions about certain fields in the matrix, which will always be true for valid matrices.
+// The conversion is fully unrolled, since the fourth column is always (0, 0, 0, 1) and doesn't need converting.
 OPTIMIZE_OS void mtxf_to_mtx_fast(s16* dst, float* src) {
     PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.matrix);
     float scale = construct_float(65536.0f / WORLD_SCALE);
-    // Iterate over pairs of values in the input matrix
-    for (int i = 0; i < 8; i++)
-    {
-        // Read the first input in the current pair
-        float a = src[2 * i + 0];
-
-        // Convert the first input to fixed
-        s32 a_int = (s32)(a * scale);
-        dst[2 * i +  0] = (s16)(a_int >> 16);
-        dst[2 * i + 16] = (s16)(a_int >>  0);
-
-        // If this is the left half of the matrix, convert the second input to fixed
-        if ((i & 1) == 0)
-        {
-            // Read the second input in the current pair
-            float b = src[2 * i + 1];
-            s32 b_int = (s32)(b * scale);
-            dst[2 * i +  1] = (s16)(b_int >> 16);
-            dst[2 * i + 17] = (s16)(b_int >>  0);
-        }
-        // Otherwise, skip the second input because column 4 will always be zero
-        // Row 4 column 4 is handled after the loop.
-        else
-        {
-            dst[2 * i +  1] = 0;
-            dst[2 * i + 17] = 0;
-        }
 
-    }
-    // Write 1.0 to the bottom right entry in the output matrix
-    // The low half was already set to zero in the loop, so we only need
-    //  to set the top half.
+    MTXF_TO_MTX_ELEMENT(dst, src,  0, scale);
+    MTXF_TO_MTX_ELEMENT(dst, src,  1, scale);
+    MTXF_TO_MTX_ELEMENT(dst, src,  2, scale);
+    MTXF_TO_MTX_ELEMENT(dst, src,  4, scale);
+    MTXF_TO_MTX_ELEMENT(dst, src,  5, scale);
+    MTXF_TO_MTX_ELEMENT(dst, src,  6, scale);
+    MTXF_TO_MTX_ELEMENT(dst, src,  8, scale);
+    MTXF_TO_MTX_ELEMENT(dst, src,  9, scale);
+    MTXF_TO_MTX_ELEMENT(dst, src, 10, scale);
+    MTXF_TO_MTX_ELEMENT(dst, src, 12, scale);
+    MTXF_TO_MTX_ELEMENT(dst, src, 13, scale);
+    MTXF_TO_MTX_ELEMENT(dst, src, 14, scale);
+
+    // Write the fourth column, which is 0 in the first three rows and 1.0 in the last.
+    dst[ 3] = 0;
+    dst[ 7] = 0;
+    dst[11] = 0;
     dst[15] = 1;
+    dst[19] = 0;
+    dst[23] = 0;
+    dst[27] = 0;
+    dst[31] = 0;
 }
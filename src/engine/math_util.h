@@ -110,6 +110,9 @@ extern f32 gSineTable[];
 #define vec3_same(v, s)     (((v)[0]) = ((v)[1]) = ((v)[2])            = (s))
 #define vec4_same(v, s)     (((v)[0]) = ((v)[1]) = ((v)[2]) = ((v)[3]) = (s))
 
+#define vec2_equal(a, b)    ((((a)[0]) == ((b)[0])) && (((a)[1]) == ((b)[1])))
+#define vec3_equal(a, b)    (vec2_equal((a), (b)) && (((a)[2]) == ((b)[2])))
+
 #define vec2_zero(v)        (vec2_same((v), 0))
 #define vec3_zero(v)        (vec3_same((v), 0))
 #define vec4_zero(v)        (vec4_same((v), 0))
@@ -462,6 +465,8 @@ extern s32 roundf(f32);
 #define FLT_IS_NONZERO(x) (absf(x) > NEAR_ZERO)
 
 u16 random_u16(void);
+u16 random_get_seed(void);
+void random_set_seed(u16 seed);
 f32 random_float(void);
 s32 random_sign(void);
 
@@ -592,6 +597,10 @@ f32 atan2f(f32 a, f32 b);
 void spline_get_weights(Vec4f result, f32 t, UNUSED s32 c);
 void anim_spline_init(Vec4s *keyFrames);
 s32  anim_spline_poll(Vec3f result);
+// Surfaces that raycasts pass straight through. The static surface BVH leaves them out entirely.
+#define IS_RAYCAST_IGNORED_SURFACE(surf) (((surf)->type == SURFACE_INTANGIBLE) || ((surf)->flags & SURFACE_FLAG_NO_CAM_COLLISION))
+
+s32 ray_surface_intersect(Vec3f orig, Vec3f dir, f32 dir_length, struct Surface *surface, Vec3f hit_pos, f32 *length);
 f32 find_surface_on_ray(Vec3f orig, Vec3f dir, struct Surface **hit_surface, Vec3f hit_pos, s32 flags);
 
 ALWAYS_INLINE f32 remap(f32 x, f32 fromA, f32 toA, f32 fromB, f32 toB) {
@@ -0,0 +1,253 @@
+#include <PR/ultratypes.h>
+
+#include "sm64.h"
+#include "game/memory.h"
+#include "game/puppyprint.h"
+#include "math_util.h"
+#include "surface_bvh.h"
+#include "surface_collision.h"
+#include "surface_load.h"
+
+#include "config.h"
+
+#ifdef STATIC_SURFACE_BVH
+
+/**
+ * Bounding volume hierarchy over the static surfaces of the current area, used to speed up raycasts.
+ * Built once when the area's terrain is loaded.
+ */
+struct SurfaceBVH gStaticSurfaceBVH;
+
+static u16 sNumBVHNodes;
+
+/**
+ * Returns the RaycastFlags bit that a ray needs to be able to hit this surface, matching the
+ * partition list add_surface_to_cell would put it in.
+ */
+static s32 get_surface_ray_flag(struct Surface *surf) {
+    if (SURFACE_IS_NEW_WATER(surf->type)) {
+        return RAYCAST_FIND_WATER;
+    } else if (surf->normal.y > NORMAL_FLOOR_THRESHOLD) {
+        return RAYCAST_FIND_FLOOR;
+    } else if (surf->normal.y < NORMAL_CEIL_THRESHOLD) {
+        return RAYCAST_FIND_CEIL;
+    }
+    return RAYCAST_FIND_WALL;
+}
+
+/**
+ * Three times the centroid of a surface along an axis. Only used for comparisons, so there's no need to divide.
+ */
+static s32 get_surface_centroid(struct Surface *surf, s32 axis) {
+    return (surf->vertex1[axis] + surf->vertex2[axis] + surf->vertex3[axis]);
+}
+
+/**
+ * Partially sorts the surfaces by their centroid along an axis, so that everything before 'median'
+ * is no further along than it, and everything after is no closer.
+ */
+static void select_median_surfaces(struct Surface **surfaces, s32 count, s32 median, s32 axis) {
+    s32 left = 0;
+    s32 right = (count - 1);
+
+    while (left < right) {
+        s32 pivot = get_surface_centroid(surfaces[(left + right) / 2], axis);
+        s32 i = left;
+        s32 j = right;
+
+        while (i <= j) {
+            while (get_surface_centroid(surfaces[i], axis) < pivot) i++;
+            while (get_surface_centroid(surfaces[j], axis) > pivot) j--;
+            if (i <= j) {
+                struct Surface *temp = surfaces[i];
+                surfaces[i] = surfaces[j];
+                surfaces[j] = temp;
+                i++;
+                j--;
+            }
+        }
+
+        if (median <= j) {
+            right = j;
+        } else if (median >= i) {
+            left = i;
+        } else {
+            break;
+        }
+    }
+}
+
+/**
+ * Recursively builds the subtree for a range of surfaces, splitting at the median centroid
+ * of the longest axis until each leaf holds at most SURFACE_BVH_LEAF_SIZE surfaces.
+ */
+static void build_bvh_node(s32 first, s32 count) {
+    struct SurfaceBVHNode *node = &gStaticSurfaceBVH.nodes[sNumBVHNodes];
+    struct Surface **surfaces = &gStaticSurfaceBVH.surfaces[first];
+    Vec3i centroidMin = {  0x7FFFFFFF,  0x7FFFFFFF,  0x7FFFFFFF };
+    Vec3i centroidMax = { -0x7FFFFFFF, -0x7FFFFFFF, -0x7FFFFFFF };
+    s32 i, axis;
+    s32 lo, hi;
+
+    sNumBVHNodes++;
+    vec3_same(node->min,  0x7FFF);
+    vec3_same(node->max, -0x7FFF);
+    node->rayFlags = 0;
+
+    for (i = 0; i < count; i++) {
+        struct Surface *surf = surfaces[i];
+        node->rayFlags |= get_surface_ray_flag(surf);
+
+        for (axis = 0; axis < 3; axis++) {
+            min_max_3i(surf->vertex1[axis], surf->vertex2[axis], surf->vertex3[axis], &lo, &hi);
+            node->min[axis] = MIN(node->min[axis], lo);
+            node->max[axis] = MAX(node->max[axis], hi);
+
+            s32 centroid = get_surface_centroid(surf, axis);
+            centroidMin[axis] = MIN(centroidMin[axis], centroid);
+            centroidMax[axis] = MAX(centroidMax[axis], centroid);
+        }
+    }
+
+    node->firstSurface = first;
+
+    if (count <= SURFACE_BVH_LEAF_SIZE) {
+        node->numSurfaces = count;
+    } else {
+        s32 median = (count / 2);
+        Vec3i extent;
+        vec3_diff(extent, centroidMax, centroidMin);
+
+        if (extent[0] >= extent[1] && extent[0] >= extent[2]) {
+            axis = 0;
+        } else if (extent[1] >= extent[2]) {
+            axis = 1;
+        } else {
+            axis = 2;
+        }
+
+        select_median_surfaces(surfaces, count, median, axis);
+
+        node->numSurfaces = 0;
+        build_bvh_node(first, median);
+        build_bvh_node((first + median), (count - median));
+    }
+
+    node->skip = sNumBVHNodes;
+}
+
+/**
+ * Removes the current BVH, so that raycasts go back to using the spatial partitions.
+ */
+void surface_bvh_reset(void) {
+    gStaticSurfaceBVH.nodes = NULL;
+    gStaticSurfaceBVH.surfaces = NULL;
+    gStaticSurfaceBVH.numNodes = 0;
+    gStaticSurfaceBVH.numSurfaces = 0;
+    gStaticSurfaceBVH.lateSurfaces[SPATIAL_PARTITION_FLOORS].next = NULL;
+    gStaticSurfaceBVH.lateSurfaces[SPATIAL_PARTITION_CEILS].next = NULL;
+    gStaticSurfaceBVH.lateSurfaces[SPATIAL_PARTITION_WALLS].next = NULL;
+    gStaticSurfaceBVH.lateSurfaces[SPATIAL_PARTITION_WATER].next = NULL;
+}
+
+/**
+ * Builds the BVH over a list of unique static surfaces. The list is reordered in place and kept by the BVH,
+ * so it must stay allocated for as long as the area is loaded.
+ */
+void surface_bvh_build(struct Surface **surfaces, s32 numSurfaces) {
+    surface_bvh_reset();
+
+    // Node indices are 16 bits, and a tree can use up to twice as many nodes as it has surfaces.
+    if (surfaces == NULL || numSurfaces <= 0 || numSurfaces > 0x7FFF) {
+        return;
+    }
+
+    s32 maxNodes = ((numSurfaces * 2) - 1);
+    struct SurfaceBVHNode *nodes = main_pool_alloc(maxNodes * sizeof(struct SurfaceBVHNode), MEMORY_POOL_LEFT);
+    if (nodes == NULL) {
+        return;
+    }
+
+    gStaticSurfaceBVH.nodes = nodes;
+    gStaticSurfaceBVH.surfaces = surfaces;
+    gStaticSurfaceBVH.numSurfaces = numSurfaces;
+
+    sNumBVHNodes = 0;
+    build_bvh_node(0, numSurfaces);
+    main_pool_realloc(nodes, sNumBVHNodes * sizeof(struct SurfaceBVHNode));
+
+    gStaticSurfaceBVH.numNodes = sNumBVHNodes;
+}
+
+/**
+ * Slab test between a ray and a node's bounds, padded by a unit so that flat nodes and surfaces lying on a
+ * node's edge aren't lost to rounding.
+ */
+static s32 ray_hits_bvh_node(struct SurfaceBVHNode *node, Vec3f orig, Vec3f invDir, f32 maxLength) {
+    f32 tMin = 0.0f;
+    f32 tMax = maxLength;
+
+    for (s32 axis = 0; axis < 3; axis++) {
+        f32 t0 = ((node->min[axis] - 1.0f) - orig[axis]) * invDir[axis];
+        f32 t1 = ((node->max[axis] + 1.0f) - orig[axis]) * invDir[axis];
+        if (t0 > t1) {
+            f32 temp = t0;
+            t0 = t1;
+            t1 = temp;
+        }
+        tMin = MAX(tMin, t0);
+        tMax = MIN(tMax, t1);
+        if (tMin > tMax) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * Finds the closest static surface along a ray using the BVH. Same parameters as find_surface_on_ray_list,
+ * except that 'flags' decides which kinds of surfaces can be hit.
+ */
+void find_surface_on_ray_bvh(Vec3f orig, Vec3f dir, f32 dir_length, struct Surface **hit_surface, Vec3f hit_pos, f32 *max_length, s32 flags) {
+    struct SurfaceBVHNode *nodes = gStaticSurfaceBVH.nodes;
+    struct Surface **surfaces = gStaticSurfaceBVH.surfaces;
+    u32 numNodes = gStaticSurfaceBVH.numNodes;
+    u32 index = 0;
+    Vec3f invDir;
+    Vec3f chk_hit_pos;
+    f32 length;
+    PUPPYPRINT_GET_SNAPSHOT();
+
+    // Axes the ray doesn't move along get a huge inverse instead, which puts the slab at +-infinity when outside it.
+    for (s32 axis = 0; axis < 3; axis++) {
+        invDir[axis] = (absf(dir[axis]) > NEAR_ZERO) ? (1.0f / dir[axis]) : 1e30f;
+    }
+
+    while (index < numNodes) {
+        struct SurfaceBVHNode *node = &nodes[index];
+
+        if (!(node->rayFlags & flags) || !ray_hits_bvh_node(node, orig, invDir, *max_length)) {
+            index = node->skip;
+            continue;
+        }
+
+        for (s32 i = 0; i < node->numSurfaces; i++) {
+            struct Surface *surf = surfaces[node->firstSurface + i];
+
+            if ((get_surface_ray_flag(surf) & flags)
+             && ray_surface_intersect(orig, dir, dir_length, surf, chk_hit_pos, &length)
+             && (length <= *max_length)) {
+                *hit_surface = surf;
+                vec3f_copy(hit_pos, chk_hit_pos);
+                *max_length = length;
+            }
+        }
+
+        // Leaves have no children, so this is the same node as 'skip' for them.
+        index++;
+    }
+    profiler_collision_update(first);
+}
+
+#endif
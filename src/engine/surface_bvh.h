@@ -0,0 +1,55 @@
+#ifndef SURFACE_BVH_H
+#define SURFACE_BVH_H
+
+#include <PR/ultratypes.h>
+
+#include "surface_load.h"
+#include "types.h"
+
+#include "config.h"
+
+#ifdef STATIC_SURFACE_BVH
+
+/**
+ * The most surfaces a BVH leaf can hold.
+ */
+#define SURFACE_BVH_LEAF_SIZE 4
+
+/**
+ * The BVH is stored in depth-first order, so a node's first child always directly follows it.
+ * 'skip' is the index of the next node to visit once this node's subtree is done (or missed),
+ * which lets the ray traversal run without a stack.
+ */
+struct SurfaceBVHNode {
+    /*0x00*/ Vec3t min;
+    /*0x06*/ Vec3t max;
+    /*0x0C*/ u16 skip;
+    /*0x0E*/ u16 firstSurface;
+    /*0x10*/ u8 numSurfaces; // 0 for inner nodes.
+    /*0x11*/ u8 rayFlags; // RaycastFlags of every surface in this subtree.
+};
+
+struct SurfaceBVH {
+    struct SurfaceBVHNode *nodes;
+    struct Surface **surfaces;
+    u16 numNodes;
+    u16 numSurfaces;
+    // Static surfaces loaded after the BVH was built (by load_object_static_model), which are checked linearly.
+    SpatialPartitionCell lateSurfaces;
+};
+
+extern struct SurfaceBVH gStaticSurfaceBVH;
+
+#define surface_bvh_is_active() (gStaticSurfaceBVH.numNodes != 0)
+
+void surface_bvh_reset(void);
+void surface_bvh_build(struct Surface **surfaces, s32 numSurfaces);
+void find_surface_on_ray_bvh(Vec3f orig, Vec3f dir, f32 dir_length, struct Surface **hit_surface, Vec3f hit_pos, f32 *max_length, s32 flags);
+
+#else
+
+#define surface_bvh_is_active() FALSE
+
+#endif
+
+#endif // SURFACE_BVH_H
@@ -46,6 +46,28 @@ s32 check_wall_edge(Vec3f vert, Vec3f v2, f32 *d00, f32 *d01, f32 *invDenom, f32
     return TRUE;
 }
 
+/**
+ * Returns whether a wall should be ignored by the current collision check.
+ */
+ALWAYS_INLINE static s32 should_skip_wall(struct Surface *surf) {
+    // Determine if checking for the camera or not.
+    if (gCollisionFlags & COLLISION_FLAG_CAMERA) {
+        return (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION);
+    }
+
+    // Ignore camera only surfaces.
+    if (surf->type == SURFACE_CAMERA_BOUNDARY) return TRUE;
+
+    if (surf->type == SURFACE_VANISH_CAP_WALLS && o != NULL) {
+        // If an object can pass through a vanish cap wall, pass through.
+        if (o->activeFlags & ACTIVE_FLAG_MOVE_THROUGH_GRATE) return TRUE;
+        // If Mario has a vanish cap, pass through the vanish cap wall.
+        if (o == gMarioObject && gMarioState->flags & MARIO_VANISH_CAP) return TRUE;
+    }
+
+    return FALSE;
+}
+
 /**
  * Iterate through the list of walls until all walls are checked and
  * have given their wall push.
@@ -60,7 +82,6 @@ static s32 find_wall_collisions_from_list(struct SurfaceNode *surfaceNode, struc
     Vec3f v0, v1, v2;
     f32 d00, d01, d11, d20, d21;
     f32 invDenom;
-    TerrainData type = SURFACE_DEFAULT;
     s32 numCols = 0;
 
     // Max collision radius = 200
@@ -74,26 +95,11 @@ static s32 find_wall_collisions_from_list(struct SurfaceNode *surfaceNode, struc
     while (surfaceNode != NULL) {
         surf        = surfaceNode->surface;
         surfaceNode = surfaceNode->next;
-        type        = surf->type;
 
         // Exclude a large number of walls immediately to optimize.
         if (pos[1] < surf->lowerY || pos[1] > surf->upperY) continue;
 
-        // Determine if checking for the camera or not.
-        if (gCollisionFlags & COLLISION_FLAG_CAMERA) {
-            if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) continue;
-        } else {
-            // Ignore camera only surfaces.
-            if (type == SURFACE_CAMERA_BOUNDARY) continue;
-
-            // If an object can pass through a vanish cap wall, pass through.
-            if (type == SURFACE_VANISH_CAP_WALLS && o != NULL) {
-                // If an object can pass through a vanish cap wall, pass through.
-                if (o->activeFlags & ACTIVE_FLAG_MOVE_THROUGH_GRATE) continue;
-                // If Mario has a vanish cap, pass through the vanish cap wall.
-                if (o == gMarioObject && gMarioState->flags & MARIO_VANISH_CAP) continue;
-            }
-        }
+        if (should_skip_wall(surf)) continue;
 
         // Dot of normal and pos, + origin offset
         offset = (surf->normal.x * pos[0])
@@ -256,6 +262,206 @@ void resolve_and_return_wall_collisions(Vec3f pos, f32 offset, f32 radius, struc
     pos[2] = collisionData->z;
 }
 
+#ifdef SWEPT_WALL_COLLISION
+/**
+ * Returns the earliest fraction of the sweep from 'from' to 'to' at which a circle of the given radius
+ * reaches the point p, looking only at X and Z. Returns a value above 1.0f if it never does, or if it
+ * already touches it at the start, as the regular wall check takes care of that.
+ */
+static f32 sweep_circle_point(Vec3f from, Vec3f dir, f32 px, f32 pz, f32 radius) {
+    f32 mx = (from[0] - px);
+    f32 mz = (from[2] - pz);
+    f32 a = (sqr(dir[0]) + sqr(dir[2]));
+    f32 b = ((mx * dir[0]) + (mz * dir[2]));
+    f32 c = (sqr(mx) + sqr(mz) - sqr(radius));
+    f32 disc = (sqr(b) - (a * c));
+
+    if (c <= 0.0f || b >= 0.0f || disc < 0.0f || !FLT_IS_NONZERO(a)) {
+        return 2.0f;
+    }
+
+    return ((-b - sqrtf(disc)) / a);
+}
+
+/**
+ * Returns the earliest fraction of the sweep at which a circle of the given radius reaches the edge from
+ * v1 to v2, looking only at X and Z, or a value above 1.0f if it never does.
+ */
+static f32 sweep_circle_edge(Vec3f from, Vec3f dir, Vec3t v1, Vec3t v2, f32 radius) {
+    f32 ex = (v2[0] - v1[0]);
+    f32 ez = (v2[2] - v1[2]);
+    f32 lenSq = (sqr(ex) + sqr(ez));
+    f32 t = MIN(sweep_circle_point(from, dir, v1[0], v1[2], radius),
+                sweep_circle_point(from, dir, v2[0], v2[2], radius));
+
+    if (lenSq < 1.0f) {
+        return t;
+    }
+
+    // Where the circle first touches the side of the edge it starts on, if that's between its ends.
+    f32 invLen = (1.0f / sqrtf(lenSq));
+    f32 dist = (((from[0] - v1[0]) * -ez) + ((from[2] - v1[2]) * ex)) * invLen;
+    f32 speed = ((dir[0] * -ez) + (dir[2] * ex)) * invLen;
+    f32 side = ((dist >= 0.0f) ? radius : -radius);
+
+    if (absf(dist) > radius && (dist * speed) < 0.0f) {
+        f32 tSide = ((side - dist) / speed);
+        f32 u = ((((from[0] + (dir[0] * tSide)) - v1[0]) * ex) + (((from[2] + (dir[2] * tSide)) - v1[2]) * ez)) / lenSq;
+
+        if (u >= 0.0f && u <= 1.0f) {
+            t = MIN(t, tSide);
+        }
+    }
+
+    return t;
+}
+
+/**
+ * Iterate through the list of walls and find the earliest point along the sweep
+ * at which the cylinder touches the front of one of them, or one of their edges or corners.
+ */
+static void find_wall_sweep_from_list(struct SurfaceNode *surfaceNode, Vec3f from, Vec3f to, f32 radius, struct Surface **pwall, f32 *toi) {
+    struct Surface *surf;
+    Vec3f dir, contact, v0, v1, v2;
+    f32 d00, d01, d11, d20, d21;
+    f32 invDenom;
+    f32 startOffset, endOffset, t;
+
+    vec3_diff(dir, to, from);
+
+    while (surfaceNode != NULL) {
+        surf        = surfaceNode->surface;
+        surfaceNode = surfaceNode->next;
+
+        if (should_skip_wall(surf)) continue;
+
+        startOffset = (surf->normal.x * from[0])
+                    + (surf->normal.y * from[1])
+                    + (surf->normal.z * from[2])
+                    + surf->originOffset;
+
+        endOffset = (surf->normal.x * to[0])
+                  + (surf->normal.y * to[1])
+                  + (surf->normal.z * to[2])
+                  + surf->originOffset;
+
+        // Never gets within the radius of the wall, or stays behind it.
+        if (MIN(startOffset, endOffset) >= radius || MAX(startOffset, endOffset) < 0.0f) continue;
+
+        if (startOffset >= radius) {
+            // Where the cylinder reaches the plane of the wall.
+            t = ((startOffset - radius) / (startOffset - endOffset));
+
+            // Exclude walls that are hit later than the current earliest hit.
+            if (t >= *toi) continue;
+
+            vec3_prod_val(contact, dir, t);
+            vec3_add(contact, from);
+
+            if (contact[1] >= surf->lowerY && contact[1] <= surf->upperY) {
+                // Check that the contact point is within the face of the wall.
+                vec3_diff(v0, surf->vertex2, surf->vertex1);
+                vec3_diff(v1, surf->vertex3, surf->vertex1);
+                vec3_diff(v2, contact,       surf->vertex1);
+
+                d00 = vec3_dot(v0, v0);
+                d01 = vec3_dot(v0, v1);
+                d11 = vec3_dot(v1, v1);
+                d20 = vec3_dot(v2, v0);
+                d21 = vec3_dot(v2, v1);
+
+                invDenom = (d00 * d11) - (d01 * d01);
+                if (FLT_IS_NONZERO(invDenom)) {
+                    invDenom = 1.0f / invDenom;
+                }
+
+                if (!check_wall_vw(d00, d01, d11, d20, d21, invDenom)) {
+                    *toi = t;
+                    *pwall = surf;
+                    continue;
+                }
+            }
+        }
+
+        // The face is missed, but the cylinder can still catch one of the wall's edges or corners,
+        // like the edge checks in find_wall_collisions_from_list.
+        t = MIN(sweep_circle_edge(from, dir, surf->vertex1, surf->vertex2, radius),
+                sweep_circle_edge(from, dir, surf->vertex2, surf->vertex3, radius));
+        t = MIN(t, sweep_circle_edge(from, dir, surf->vertex3, surf->vertex1, radius));
+
+        if (t < 0.0f || t >= *toi) continue;
+
+        // Only edges approached from the front count, the same as the face.
+        if ((startOffset + ((endOffset - startOffset) * t)) < 0.0f) continue;
+
+        contact[1] = (from[1] + (dir[1] * t));
+        if (contact[1] < surf->lowerY || contact[1] > surf->upperY) continue;
+
+        *toi = t;
+        *pwall = surf;
+    }
+}
+
+/**
+ * Sweep a wall collision cylinder from one position to another, and find the first wall it hits.
+ * Returns the fraction of the movement that can be made before touching that wall, or 1.0f if
+ * nothing is in the way. Unlike find_wall_collisions, this can't skip over walls at high speeds.
+ */
+f32 find_wall_sweep(Vec3f from, Vec3f to, f32 offsetY, f32 radius, struct Surface **pwall) {
+    f32 toi = 1.0f;
+    struct Surface *wall = NULL;
+    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_wall);
+    PUPPYPRINT_GET_SNAPSHOT();
+
+    if (pwall != NULL) {
+        *pwall = NULL;
+    }
+
+    if (is_outside_level_bounds(from[0], from[2]) || is_outside_level_bounds(to[0], to[2])) {
+        gCollisionFlags &= ~(COLLISION_FLAG_RETURN_FIRST | COLLISION_FLAG_EXCLUDE_DYNAMIC | COLLISION_FLAG_INCLUDE_INTANGIBLE);
+        profiler_collision_update(first);
+        return toi;
+    }
+
+    // Max collision radius = 200
+    if (radius > 200) {
+        radius = 200;
+    }
+
+    Vec3f start = { from[0], from[1] + offsetY, from[2] };
+    Vec3f end   = {   to[0],   to[1] + offsetY,   to[2] };
+
+    // Check every cell the sweep passes through.
+    s32 minCellX = GET_CELL_COORD(MIN(start[0], end[0]));
+    s32 maxCellX = GET_CELL_COORD(MAX(start[0], end[0]));
+    s32 minCellZ = GET_CELL_COORD(MIN(start[2], end[2]));
+    s32 maxCellZ = GET_CELL_COORD(MAX(start[2], end[2]));
+
+    s32 includeDynamic = !(gCollisionFlags & COLLISION_FLAG_EXCLUDE_DYNAMIC);
+
+    for (s32 cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+        for (s32 cellX = minCellX; cellX <= maxCellX; cellX++) {
+            if (includeDynamic) {
+                // Check for surfaces belonging to objects.
+                find_wall_sweep_from_list(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS].next, start, end, radius, &wall, &toi);
+            }
+
+            // Check for surfaces that are a part of level geometry.
+            find_wall_sweep_from_list(gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_WALLS].next, start, end, radius, &wall, &toi);
+        }
+    }
+
+    gCollisionFlags &= ~(COLLISION_FLAG_RETURN_FIRST | COLLISION_FLAG_EXCLUDE_DYNAMIC | COLLISION_FLAG_INCLUDE_INTANGIBLE);
+
+    if (pwall != NULL) {
+        *pwall = wall;
+    }
+
+    profiler_collision_update(first);
+    return toi;
+}
+#endif
+
 /**************************************************
  *                     CEILINGS                   *
  **************************************************/
@@ -649,6 +855,292 @@ f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor) {
     return height;
 }
 
+/**
+ * The positions being checked by find_floors_batch that share a cell, and their results for the current list.
+ */
+struct FloorBatchLanes {
+    s32 x[FLOOR_BATCH_LANES];
+    s32 z[FLOOR_BATCH_LANES];
+    s32 bufferY[FLOOR_BATCH_LANES];
+    f32 height[FLOOR_BATCH_LANES];
+    struct Surface *floor[FLOOR_BATCH_LANES];
+    s32 numLanes;
+};
+
+/**
+ * Same as find_floor_from_list, but for several positions at once, so the list only has to be walked once.
+ * The checks that only depend on the surface are done once per surface rather than once per position.
+ */
+static void find_floor_from_list_batch(struct SurfaceNode *surfaceNode, struct FloorBatchLanes *lanes) {
+    register struct Surface *surf;
+    register SurfaceType type;
+    register f32 height;
+    u32 activeLanes = ((1 << lanes->numLanes) - 1);
+    s32 i;
+
+    for (i = 0; i < lanes->numLanes; i++) {
+        lanes->floor[i] = NULL;
+    }
+
+    while ((surfaceNode != NULL) && activeLanes) {
+        surf = surfaceNode->surface;
+        surfaceNode = surfaceNode->next;
+        type        = surf->type;
+
+        if (!(gCollisionFlags & COLLISION_FLAG_INCLUDE_INTANGIBLE) && (type == SURFACE_INTANGIBLE)) {
+            continue;
+        }
+
+        if (gCollisionFlags & COLLISION_FLAG_CAMERA) {
+            if (surf->flags & SURFACE_FLAG_NO_CAM_COLLISION) {
+                continue;
+            }
+        } else if (type == SURFACE_CAMERA_BOUNDARY) {
+            continue;
+        }
+
+        for (i = 0; i < lanes->numLanes; i++) {
+            if (!(activeLanes & (1 << i))) continue;
+            if (lanes->bufferY[i] < surf->lowerY) continue;
+            if (!check_within_floor_triangle_bounds(lanes->x[i], lanes->z[i], surf)) continue;
+
+            height = get_surface_height_at_location(lanes->x[i], lanes->z[i], surf);
+
+            if (height <= lanes->height[i]) continue;
+            if (lanes->bufferY[i] < height) continue;
+
+            lanes->height[i] = height;
+            lanes->floor[i] = surf;
+
+            // This position is done once no other floor can be closer.
+            if ((height == lanes->bufferY[i]) || (gCollisionFlags & COLLISION_FLAG_RETURN_FIRST)) {
+                activeLanes &= ~(1 << i);
+            }
+        }
+    }
+}
+
+/**
+ * Find the highest floor under each of a list of positions, with the same results as calling find_floor for each.
+ * Consecutive positions in the same cell are checked together, so the cell's floors are only walked once for them.
+ */
+void find_floors_batch(struct FloorQuery *queries, s32 numQueries) {
+    PUPPYPRINT_GET_SNAPSHOT();
+    struct FloorBatchLanes lanes;
+    struct Surface *dynamicFloor[FLOOR_BATCH_LANES];
+    f32 dynamicHeight[FLOOR_BATCH_LANES];
+    s32 includeDynamic = !(gCollisionFlags & COLLISION_FLAG_EXCLUDE_DYNAMIC);
+    s32 i;
+
+    while (numQueries > 0) {
+        s32 x = queries[0].pos[0];
+        s32 z = queries[0].pos[2];
+
+        if (is_outside_level_bounds(x, z)) {
+            PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_floor);
+            queries[0].height = FLOOR_LOWER_LIMIT;
+            queries[0].floor = NULL;
+            queries++;
+            numQueries--;
+            continue;
+        }
+
+        s32 cellX = GET_CELL_COORD(x);
+        s32 cellZ = GET_CELL_COORD(z);
+
+        // Gather the following positions that are in the same cell.
+        lanes.numLanes = 0;
+        while (lanes.numLanes < MIN(numQueries, FLOOR_BATCH_LANES)) {
+            struct FloorQuery *query = &queries[lanes.numLanes];
+            x = query->pos[0];
+            z = query->pos[2];
+
+            if (is_outside_level_bounds(x, z) || (GET_CELL_COORD(x) != cellX) || (GET_CELL_COORD(z) != cellZ)) {
+                break;
+            }
+
+            lanes.x[lanes.numLanes] = x;
+            lanes.z[lanes.numLanes] = z;
+            lanes.bufferY[lanes.numLanes] = ((s32) query->pos[1] + FIND_FLOOR_BUFFER);
+            lanes.height[lanes.numLanes] = FLOOR_LOWER_LIMIT;
+            lanes.numLanes++;
+        }
+
+        if (includeDynamic) {
+            find_floor_from_list_batch(gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next, &lanes);
+
+            for (i = 0; i < lanes.numLanes; i++) {
+                dynamicFloor[i] = lanes.floor[i];
+                dynamicHeight[i] = lanes.height[i];
+            }
+        }
+
+        find_floor_from_list_batch(gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next, &lanes);
+
+        for (i = 0; i < lanes.numLanes; i++) {
+            PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_floor);
+
+            if (includeDynamic && (lanes.height[i] <= dynamicHeight[i])) {
+                lanes.floor[i] = dynamicFloor[i];
+                lanes.height[i] = dynamicHeight[i];
+            }
+
+            if (lanes.floor[i] == NULL) {
+                gNumFindFloorMisses++;
+            }
+#ifdef VANILLA_DEBUG
+            gNumCalls.floor++;
+#endif
+
+            queries[i].height = lanes.height[i];
+            queries[i].floor = lanes.floor[i];
+        }
+
+        queries += lanes.numLanes;
+        numQueries -= lanes.numLanes;
+    }
+
+    gCollisionFlags &= ~(COLLISION_FLAG_RETURN_FIRST | COLLISION_FLAG_EXCLUDE_DYNAMIC | COLLISION_FLAG_INCLUDE_INTANGIBLE);
+    profiler_collision_update(first);
+}
+
+#ifdef OBJECT_FLOOR_CACHE
+/**
+ * Project a floor's vertices onto a lateral axis and return the covered range.
+ */
+static void project_floor_on_axis(f32 vx[3], f32 vz[3], f32 axisX, f32 axisZ, f32 *min, f32 *max) {
+    f32 proj;
+    *min = *max = (vx[0] * axisX) + (vz[0] * axisZ);
+
+    for (s32 i = 1; i < 3; i++) {
+        proj = (vx[i] * axisX) + (vz[i] * axisZ);
+        if (proj < *min) *min = proj;
+        if (proj > *max) *max = proj;
+    }
+}
+
+/**
+ * Returns whether two floors overlap when viewed from above. Floors that only share
+ * an edge or a vertex count too, since find_floor's point-in-triangle test includes the edges.
+ */
+static s32 floors_overlap_laterally(struct Surface *a, struct Surface *b) {
+    f32 vx[2][3] = {
+        { a->vertex1[0], a->vertex2[0], a->vertex3[0] },
+        { b->vertex1[0], b->vertex2[0], b->vertex3[0] },
+    };
+    f32 vz[2][3] = {
+        { a->vertex1[2], a->vertex2[2], a->vertex3[2] },
+        { b->vertex1[2], b->vertex2[2], b->vertex3[2] },
+    };
+    f32 minA, maxA, minB, maxB;
+
+    // Separating axis test against the normal of each edge of both triangles.
+    for (s32 t = 0; t < 2; t++) {
+        for (s32 i = 0; i < 3; i++) {
+            s32 j = (i == 2) ? 0 : (i + 1);
+            f32 axisX = vz[t][j] - vz[t][i];
+            f32 axisZ = vx[t][i] - vx[t][j];
+
+            project_floor_on_axis(vx[0], vz[0], axisX, axisZ, &minA, &maxA);
+            project_floor_on_axis(vx[1], vz[1], axisX, axisZ, &minB, &maxB);
+
+            if (maxA < minB || maxB < minA) return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * Find the lowest point at which a static floor overlapping the given floor starts.
+ * Below that point, the given floor is the highest floor anywhere inside its own bounds.
+ */
+static f32 get_floor_cache_max_y(struct SurfaceNode *surfaceNode, struct Surface *floor) {
+    f32 maxY = CELL_HEIGHT_LIMIT;
+
+    while (surfaceNode != NULL) {
+        struct Surface *surf = surfaceNode->surface;
+        surfaceNode = surfaceNode->next;
+
+        // Floors are sorted from highest to lowest, so everything from here on is below the floor.
+        if (surf->upperY <= floor->lowerY) break;
+
+        if (surf == floor || surf->lowerY >= maxY) continue;
+        if (!floors_overlap_laterally(floor, surf)) continue;
+
+        maxY = surf->lowerY;
+    }
+
+    return maxY;
+}
+
+/**
+ * Find the highest floor under a given position, reusing the static floor stored in the cache
+ * when the point is still inside it, so the static cell list doesn't need to be walked again.
+ */
+f32 find_floor_cached(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor, struct FloorCache *cache) {
+    struct Surface *floor = cache->floor;
+    s32 x = xPos;
+    s32 y = yPos;
+    s32 z = zPos;
+
+    // Collision flags change which floors are valid, so only plain queries can use the cache.
+    if (gCollisionFlags != COLLISION_FLAGS_NONE || is_outside_level_bounds(x, z)) {
+        return find_floor(xPos, yPos, zPos, pfloor);
+    }
+
+    s32 cellX = GET_CELL_COORD(x);
+    s32 cellZ = GET_CELL_COORD(z);
+    s32 bufferY = y + FIND_FLOOR_BUFFER;
+
+    if (floor != NULL
+        && cache->loadCount == gStaticSurfaceLoadCount
+        && cache->cellX == cellX
+        && cache->cellZ == cellZ
+        && bufferY < cache->maxY
+        && check_within_floor_triangle_bounds(x, z, floor)) {
+        f32 height = get_surface_height_at_location(x, z, floor);
+
+        if (height <= bufferY) {
+            PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_floor_cache_hit);
+            PUPPYPRINT_GET_SNAPSHOT();
+            f32 dynamicHeight = FLOOR_LOWER_LIMIT;
+
+            // Dynamic floors are rebuilt every frame, so they still need to be checked.
+            struct SurfaceNode *surfaceList = gDynamicSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next;
+            struct Surface *dynamicFloor = find_floor_from_list(surfaceList, x, y, z, &dynamicHeight);
+
+            // Use the higher floor.
+            if (height <= dynamicHeight) {
+                floor  = dynamicFloor;
+                height = dynamicHeight;
+            }
+
+            *pfloor = floor;
+            profiler_collision_update(first);
+            return height;
+        }
+    }
+
+    PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.collision_floor_cache_miss);
+    f32 height = find_floor(xPos, yPos, zPos, pfloor);
+    floor = *pfloor;
+
+    // Dynamic floors are cleared every frame, so only cache static ones.
+    if (floor != NULL && !(floor->flags & SURFACE_FLAG_DYNAMIC)) {
+        cache->floor = floor;
+        cache->maxY = get_floor_cache_max_y(gStaticSurfacePartition[cellZ][cellX][SPATIAL_PARTITION_FLOORS].next, floor);
+        cache->cellX = cellX;
+        cache->cellZ = cellZ;
+        cache->loadCount = gStaticSurfaceLoadCount;
+    } else {
+        cache->floor = NULL;
+    }
+
+    return height;
+}
+#endif
+
 f32 find_room_floor(f32 x, f32 y, f32 z, struct Surface **pfloor) {
     gCollisionFlags |= (COLLISION_FLAG_EXCLUDE_DYNAMIC | COLLISION_FLAG_INCLUDE_INTANGIBLE);
 
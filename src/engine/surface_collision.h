@@ -33,6 +33,17 @@ enum RaycastFlags {
     RAYCAST_FIND_ALL   = (0xFFFFFFFF)
 };
 
+/**
+ * The most positions find_floors_batch checks against a cell at once.
+ */
+#define FLOOR_BATCH_LANES 8
+
+struct FloorQuery {
+    Vec3f pos;
+    f32 height;
+    struct Surface *floor;
+};
+
 struct WallCollisionData {
     /*0x00*/ f32 x, y, z;
     /*0x0C*/ f32 offsetY;
@@ -45,6 +56,9 @@ struct WallCollisionData {
 s32 f32_find_wall_collision(f32 *xPtr, f32 *yPtr, f32 *zPtr, f32 offsetY, f32 radius);
 s32 find_wall_collisions(struct WallCollisionData *colData);
 void resolve_and_return_wall_collisions(Vec3f pos, f32 offset, f32 radius, struct WallCollisionData *collisionData);
+#ifdef SWEPT_WALL_COLLISION
+f32 find_wall_sweep(Vec3f from, Vec3f to, f32 offsetY, f32 radius, struct Surface **pwall);
+#endif
 f32 find_ceil(f32 posX, f32 posY, f32 posZ, struct Surface **pceil);
 
 // Finds the ceiling from a vec3f and a minimum height (with 3 unit vertical buffer).
@@ -54,6 +68,10 @@ ALWAYS_INLINE f32 find_mario_ceil(Vec3f pos, f32 height, struct Surface **ceil)
 
 f32 find_floor_height(f32 x, f32 y, f32 z);
 f32 find_floor(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor);
+void find_floors_batch(struct FloorQuery *queries, s32 numQueries);
+#ifdef OBJECT_FLOOR_CACHE
+f32 find_floor_cached(f32 xPos, f32 yPos, f32 zPos, struct Surface **pfloor, struct FloorCache *cache);
+#endif
 f32 find_room_floor(f32 x, f32 y, f32 z, struct Surface **pfloor);
 s32 get_room_at_pos(f32 x, f32 y, f32 z);
 s32 find_water_level_and_floor(s32 x, s32 y, s32 z, struct Surface **pfloor);
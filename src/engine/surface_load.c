@@ -13,6 +13,7 @@
 #include "game/mario.h"
 #include "game/object_list_processor.h"
 #include "surface_load.h"
+#include "surface_bvh.h"
 #include "game/puppyprint.h"
 #include "game/debug.h"
 
@@ -29,7 +30,12 @@ struct CellCoords {
     u8 x;
     u8 partition;
 };
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+// Resting surfaces stay in their cells between frames, so more cells can be in use at once.
+struct CellCoords sCellsUsed[NUM_CELLS * NUM_SPATIAL_PARTITIONS];
+#else
 struct CellCoords sCellsUsed[NUM_CELLS];
+#endif
 u16 sNumCellsUsed;
 u8 sClearAllCells;
 
@@ -52,14 +58,59 @@ void *gDynamicSurfacePoolEnd;
  */
 u32 gTotalStaticSurfaceData;
 
+/**
+ * Incremented every time static surfaces are loaded, so anything holding on to
+ * a static surface pointer can tell when it may have gone stale.
+ */
+u16 gStaticSurfaceLoadCount;
+
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+/**
+ * The surfaces of objects that haven't moved since the last frame are "resting", and aren't cleared every frame.
+ * They're allocated downwards from the end of the dynamic surface pool, so this is the start of the resting data.
+ */
+void *gRestingSurfacePoolStart;
+
+struct DynamicSurfaceObject {
+    struct Object *obj;          // The object using this slot, or NULL if it's free.
+    TerrainData *collisionData;  // The collision model the surfaces were loaded from.
+    Mat4 transform;              // The object's transform the surfaces were loaded with.
+    Vec3f scale;                 // The object's scale the surfaces were loaded with.
+    u8 checkedIn;                // Whether the object loaded its collision since the last clear.
+    u8 resting;                  // Whether the object's surfaces are resting.
+};
+
+static struct DynamicSurfaceObject sDynamicSurfaceObjects[DYNAMIC_SURFACE_OBJECT_SLOTS];
+static s32 sNumRestingSurfaces;
+static s32 sNumRestingSurfaceNodes;
+static u8 sLoadingRestingSurfaces;
+static u8 sRebuildDynamicSurfaces;
+
+/**
+ * Allocate data from the resting end of the dynamic surface pool.
+ */
+static void *alloc_resting_surface_data(u32 size) {
+    gRestingSurfacePoolStart = ((u8 *) gRestingSurfacePoolStart - size);
+    return gRestingSurfacePoolStart;
+}
+#endif
+
 /**
  * Allocate the part of the surface node pool to contain a surface node.
  */
 static struct SurfaceNode *alloc_surface_node(u32 dynamic) {
     struct SurfaceNode **poolEnd = (struct SurfaceNode **)(dynamic ? &gDynamicSurfacePoolEnd : &gCurrStaticSurfacePoolEnd);
 
-    struct SurfaceNode *node = *poolEnd;
-    (*poolEnd)++;
+    struct SurfaceNode *node;
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    if (dynamic && sLoadingRestingSurfaces) {
+        node = alloc_resting_surface_data(sizeof(struct SurfaceNode));
+    } else {
+        node = (*poolEnd)++;
+    }
+#else
+    node = (*poolEnd)++;
+#endif
     gSurfaceNodesAllocated++;
 
     node->next = NULL;
@@ -73,9 +124,17 @@ static struct SurfaceNode *alloc_surface_node(u32 dynamic) {
  */
 static struct Surface *alloc_surface(u32 dynamic) {
     struct Surface **poolEnd = (struct Surface **)(dynamic ? &gDynamicSurfacePoolEnd : &gCurrStaticSurfacePoolEnd);
-    
-    struct Surface *surface = *poolEnd;
-    (*poolEnd)++;
+
+    struct Surface *surface;
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    if (dynamic && sLoadingRestingSurfaces) {
+        surface = alloc_resting_surface_data(sizeof(struct Surface));
+    } else {
+        surface = (*poolEnd)++;
+    }
+#else
+    surface = (*poolEnd)++;
+#endif
     gSurfacesAllocated++;
 
     surface->type = SURFACE_DEFAULT;
@@ -111,6 +170,20 @@ static void clear_static_surfaces(void) {
     clear_spatial_partition(&gStaticSurfacePartition[0][0]);
 }
 
+/**
+ * Returns which of a cell's partition lists a surface belongs in.
+ */
+static s32 get_surface_partition(struct Surface *surface) {
+    if (SURFACE_IS_NEW_WATER(surface->type)) {
+        return SPATIAL_PARTITION_WATER;
+    } else if (surface->normal.y > NORMAL_FLOOR_THRESHOLD) {
+        return SPATIAL_PARTITION_FLOORS;
+    } else if (surface->normal.y < NORMAL_CEIL_THRESHOLD) {
+        return SPATIAL_PARTITION_CEILS;
+    }
+    return SPATIAL_PARTITION_WALLS;
+}
+
 /**
  * Add a surface to the correct cell list of surfaces.
  * @param dynamic Determines whether the surface is static or dynamic
@@ -122,17 +195,11 @@ static void add_surface_to_cell(s32 dynamic, s32 cellX, s32 cellZ, struct Surfac
     struct SurfaceNode *list;
     s32 priority;
     s32 sortDir = 1; // highest to lowest, then insertion order (water and floors)
-    s32 listIndex;
+    s32 listIndex = get_surface_partition(surface);
 
-    if (SURFACE_IS_NEW_WATER(surface->type)) {
-        listIndex = SPATIAL_PARTITION_WATER;
-    } else if (surface->normal.y > NORMAL_FLOOR_THRESHOLD) {
-        listIndex = SPATIAL_PARTITION_FLOORS;
-    } else if (surface->normal.y < NORMAL_CEIL_THRESHOLD) {
-        listIndex = SPATIAL_PARTITION_CEILS;
+    if (listIndex == SPATIAL_PARTITION_CEILS) {
         sortDir = -1; // lowest to highest, then insertion order
-    } else {
-        listIndex = SPATIAL_PARTITION_WALLS;
+    } else if (listIndex == SPATIAL_PARTITION_WALLS) {
         sortDir = 0; // insertion order
     }
 
@@ -248,6 +315,17 @@ static void add_surface(struct Surface *surface, s32 dynamic) {
             add_surface_to_cell(dynamic, cellX, cellZ, surface);
         }
     }
+
+#ifdef STATIC_SURFACE_BVH
+    // The BVH can't be added to once it's built, so raycasts check static surfaces loaded afterwards separately.
+    if (!dynamic && surface_bvh_is_active()) {
+        struct SurfaceNode *list = &gStaticSurfaceBVH.lateSurfaces[get_surface_partition(surface)];
+        struct SurfaceNode *newNode = alloc_surface_node(FALSE);
+        newNode->surface = surface;
+        newNode->next = list->next;
+        list->next = newNode;
+    }
+#endif
 }
 
 /**
@@ -431,6 +509,9 @@ static void load_environmental_regions(TerrainData **data) {
 void alloc_surface_pools(void) {
     gDynamicSurfacePool = main_pool_alloc(DYNAMIC_SURFACE_POOL_SIZE, MEMORY_POOL_LEFT);
     gDynamicSurfacePoolEnd = gDynamicSurfacePool;
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    gRestingSurfacePoolStart = ((u8 *) gDynamicSurfacePool + DYNAMIC_SURFACE_POOL_SIZE);
+#endif
 
     gCCMEnteredSlide = FALSE;
     reset_red_coins_collected();
@@ -493,6 +574,69 @@ u32 get_area_terrain_size(TerrainData *data) {
 #endif
 
 
+#ifdef STATIC_SURFACE_BVH
+/**
+ * Static surfaces are stored in every cell they overlap, so to only count each once,
+ * only take it from the first cell add_surface put it in.
+ */
+static s32 is_first_cell_of_surface(struct Surface *surface, s32 cellX, s32 cellZ) {
+    s32 minX, maxX, minZ, maxZ;
+
+    min_max_3i(surface->vertex1[0], surface->vertex2[0], surface->vertex3[0], &minX, &maxX);
+    min_max_3i(surface->vertex1[2], surface->vertex2[2], surface->vertex3[2], &minZ, &maxZ);
+
+    return ((cellX == lower_cell_index(minX)) && (cellZ == lower_cell_index(minZ)));
+}
+
+/**
+ * Goes through the static partition and collects every surface a raycast can hit, or just counts them if surfaces is NULL.
+ */
+static s32 collect_static_ray_surfaces(struct Surface **surfaces) {
+    struct SurfaceNode *node;
+    s32 cellX, cellZ, listIndex;
+    s32 numSurfaces = 0;
+
+    for (cellZ = 0; cellZ < NUM_CELLS; cellZ++) {
+        for (cellX = 0; cellX < NUM_CELLS; cellX++) {
+            for (listIndex = 0; listIndex < NUM_SPATIAL_PARTITIONS; listIndex++) {
+                for (node = gStaticSurfacePartition[cellZ][cellX][listIndex].next; node != NULL; node = node->next) {
+                    struct Surface *surface = node->surface;
+
+                    if (IS_RAYCAST_IGNORED_SURFACE(surface)) continue;
+                    if (!is_first_cell_of_surface(surface, cellX, cellZ)) continue;
+
+                    if (surfaces != NULL) {
+                        surfaces[numSurfaces] = surface;
+                    }
+                    numSurfaces++;
+                }
+            }
+        }
+    }
+
+    return numSurfaces;
+}
+
+/**
+ * Builds the raycast BVH over the area's static surfaces.
+ */
+static void load_static_surface_bvh(void) {
+    s32 numSurfaces = collect_static_ray_surfaces(NULL);
+
+    if (numSurfaces == 0) {
+        return;
+    }
+
+    struct Surface **surfaces = main_pool_alloc(numSurfaces * sizeof(struct Surface *), MEMORY_POOL_LEFT);
+    if (surfaces == NULL) {
+        return;
+    }
+
+    collect_static_ray_surfaces(surfaces);
+    surface_bvh_build(surfaces, numSurfaces);
+}
+#endif
+
 /**
  * Process the level file, loading in vertices, surfaces, some objects, and environmental
  * boxes (water, gas, JRB fog).
@@ -510,6 +654,10 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
     bzero(&sCellsUsed, sizeof(sCellsUsed));
     sNumCellsUsed = 0;
     sClearAllCells = TRUE;
+    gStaticSurfaceLoadCount++;
+#ifdef STATIC_SURFACE_BVH
+    surface_bvh_reset();
+#endif
 
     clear_static_surfaces();
 
@@ -559,9 +707,123 @@ void load_area_terrain(s32 index, TerrainData *data, RoomData *surfaceRooms, s16
 
     gNumStaticSurfaceNodes = gSurfaceNodesAllocated;
     gNumStaticSurfaces = gSurfacesAllocated;
+#ifdef STATIC_SURFACE_BVH
+    load_static_surface_bvh();
+#endif
     profiler_collision_update(first);
 }
 
+/**
+ * Empties every list of the dynamic partition that has been used.
+ */
+static void clear_dynamic_surface_partition(void) {
+    if (sClearAllCells) {
+        clear_spatial_partition(&gDynamicSurfacePartition[0][0]);
+    } else {
+        for (u32 i = 0; i < sNumCellsUsed; i++) {
+            gDynamicSurfacePartition[sCellsUsed[i].z][sCellsUsed[i].x][sCellsUsed[i].partition].next = NULL;
+        }
+    }
+    sNumCellsUsed = 0;
+    sClearAllCells = FALSE;
+}
+
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+/**
+ * Unlinks surface nodes from a dynamic partition list. If obj is NULL, every node that isn't resting is removed,
+ * otherwise only the nodes of that object's surfaces are.
+ * @return Whether the list is now empty
+ */
+static s32 remove_dynamic_surface_nodes_from_list(struct SurfaceNode *list, struct Object *obj) {
+    struct SurfaceNode *prev = list;
+    struct SurfaceNode *node;
+
+    while ((node = prev->next) != NULL) {
+        if ((obj == NULL) ? ((uintptr_t) node < (uintptr_t) gRestingSurfacePoolStart) : (node->surface->object == obj)) {
+            prev->next = node->next;
+        } else {
+            prev = node;
+        }
+    }
+
+    return (list->next == NULL);
+}
+
+/**
+ * Unlinks surface nodes from every used list of the dynamic partition, see remove_dynamic_surface_nodes_from_list.
+ */
+static void remove_dynamic_surface_nodes(struct Object *obj) {
+    s32 cellX, cellZ, listIndex;
+    u32 i = 0;
+
+    if (sClearAllCells) {
+        // The used cells stopped being tracked, so go through all of them.
+        for (cellZ = 0; cellZ < NUM_CELLS; cellZ++) {
+            for (cellX = 0; cellX < NUM_CELLS; cellX++) {
+                for (listIndex = 0; listIndex < NUM_SPATIAL_PARTITIONS; listIndex++) {
+                    remove_dynamic_surface_nodes_from_list(&gDynamicSurfacePartition[cellZ][cellX][listIndex], obj);
+                }
+            }
+        }
+        return;
+    }
+
+    while (i < sNumCellsUsed) {
+        struct CellCoords *cell = &sCellsUsed[i];
+
+        if (remove_dynamic_surface_nodes_from_list(&gDynamicSurfacePartition[cell->z][cell->x][cell->partition], obj)) {
+            // Only keep track of lists that still have something in them, so they get added again when reused.
+            *cell = sCellsUsed[--sNumCellsUsed];
+        } else {
+            i++;
+        }
+    }
+}
+
+/**
+ * Frees the slots of objects that didn't load their collision since the last clear, or were unloaded.
+ * @return FALSE if any resting surfaces need to be removed
+ */
+static s32 update_dynamic_surface_slots(void) {
+    s32 keepResting = !sRebuildDynamicSurfaces;
+
+    for (s32 i = 0; i < DYNAMIC_SURFACE_OBJECT_SLOTS; i++) {
+        struct DynamicSurfaceObject *slot = &sDynamicSurfaceObjects[i];
+
+        if (slot->obj == NULL) {
+            continue;
+        }
+
+        if (!slot->checkedIn
+         || (slot->obj->activeFlags == ACTIVE_FLAG_DEACTIVATED)
+         || (slot->obj->dynamicSurfaceSlot != i)) {
+            if (slot->resting) {
+                keepResting = FALSE;
+            }
+            slot->obj = NULL;
+        }
+
+        slot->checkedIn = FALSE;
+    }
+
+    return keepResting;
+}
+
+/**
+ * Frees all resting surfaces, so every object reloads its collision next time.
+ */
+static void clear_resting_surfaces(void) {
+    for (s32 i = 0; i < DYNAMIC_SURFACE_OBJECT_SLOTS; i++) {
+        sDynamicSurfaceObjects[i].resting = FALSE;
+    }
+
+    gRestingSurfacePoolStart = ((u8 *) gDynamicSurfacePool + DYNAMIC_SURFACE_POOL_SIZE);
+    sNumRestingSurfaces = 0;
+    sNumRestingSurfaceNodes = 0;
+    sRebuildDynamicSurfaces = FALSE;
+}
+#endif
+
 /**
  * If not in time stop, clear the surface partitions.
  */
@@ -573,15 +835,21 @@ void clear_dynamic_surfaces(void) {
         gSurfacesAllocated = gNumStaticSurfaces;
         gSurfaceNodesAllocated = gNumStaticSurfaceNodes;
         gDynamicSurfacePoolEnd = gDynamicSurfacePool;
-        if (sClearAllCells) {
-            clear_spatial_partition(&gDynamicSurfacePartition[0][0]);
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+        s32 keepResting = update_dynamic_surface_slots();
+
+        if (keepResting && !sClearAllCells) {
+            // Only the surfaces of objects that aren't resting need to be removed.
+            remove_dynamic_surface_nodes(NULL);
+            gSurfacesAllocated += sNumRestingSurfaces;
+            gSurfaceNodesAllocated += sNumRestingSurfaceNodes;
         } else {
-            for (u32 i = 0; i < sNumCellsUsed; i++) {
-                gDynamicSurfacePartition[sCellsUsed[i].z][sCellsUsed[i].x][sCellsUsed[i].partition].next = NULL;
-            }
+            clear_resting_surfaces();
+            clear_dynamic_surface_partition();
         }
-        sNumCellsUsed = 0;
-        sClearAllCells = FALSE;
+#else
+        clear_dynamic_surface_partition();
+#endif
     }
     profiler_collision_update(first);
 }
@@ -693,6 +961,122 @@ static void get_optimal_coll_dist(struct Object *obj) {
 
 static TerrainData sVertexData[600];
 
+/**
+ * Transform the current object's vertices and add its surfaces to the dynamic partition.
+ */
+static void load_object_dynamic_surfaces(TerrainData *collisionData) {
+    transform_object_vertices(&collisionData, sVertexData);
+
+    // TERRAIN_LOAD_CONTINUE acts as an "end" to the terrain data.
+    while (*collisionData != TERRAIN_LOAD_CONTINUE) {
+        load_object_surfaces(&collisionData, sVertexData, TRUE);
+    }
+}
+
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+/**
+ * Returns the current object's slot in sDynamicSurfaceObjects, claiming a free one if it doesn't have one yet.
+ * Returns NULL if every slot is taken.
+ */
+static struct DynamicSurfaceObject *get_dynamic_surface_slot(void) {
+    s32 i = o->dynamicSurfaceSlot;
+
+    if ((i < DYNAMIC_SURFACE_OBJECT_SLOTS) && (sDynamicSurfaceObjects[i].obj == o)) {
+        return &sDynamicSurfaceObjects[i];
+    }
+
+    for (i = 0; i < DYNAMIC_SURFACE_OBJECT_SLOTS; i++) {
+        struct DynamicSurfaceObject *slot = &sDynamicSurfaceObjects[i];
+
+        if (slot->obj == NULL) {
+            slot->obj = o;
+            slot->collisionData = NULL;
+            slot->checkedIn = FALSE;
+            slot->resting = FALSE;
+            o->dynamicSurfaceSlot = i;
+            return slot;
+        }
+    }
+
+    o->dynamicSurfaceSlot = DYNAMIC_SURFACE_SLOT_NONE;
+    return NULL;
+}
+
+static s32 vec3f_matches(Vec3f a, Vec3f b) {
+    return ((a[0] == b[0]) && (a[1] == b[1]) && (a[2] == b[2]));
+}
+
+/**
+ * Whether the current object is in the same pose as when its surfaces were last loaded.
+ */
+static s32 dynamic_surface_pose_matches(struct DynamicSurfaceObject *slot, TerrainData *collisionData) {
+    if ((slot->collisionData != collisionData) || !vec3f_matches(slot->scale, o->header.gfx.scale)) {
+        return FALSE;
+    }
+
+    // The last column of the transform isn't used.
+    for (s32 i = 0; i < 4; i++) {
+        if (!vec3f_matches(slot->transform[i], o->transform[i])) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+/**
+ * Loads the current object's dynamic surfaces, unless they're still resting from an earlier frame.
+ * Objects that are in the same pose two frames in a row have their surfaces loaded as resting,
+ * and they stay loaded until the object moves or stops loading its collision.
+ */
+static void update_object_dynamic_surfaces(TerrainData *collisionData) {
+    struct DynamicSurfaceObject *slot = get_dynamic_surface_slot();
+
+    if (slot == NULL) {
+        load_object_dynamic_surfaces(collisionData);
+        return;
+    }
+
+    // transform_object_vertices would build the transform if there isn't one, so do it here first to compare against it.
+    if (o->header.gfx.throwMatrix == NULL) {
+        o->header.gfx.throwMatrix = &o->transform;
+        obj_build_transform_from_pos_and_angle(o, O_POS_INDEX, O_FACE_ANGLE_INDEX);
+    }
+
+    s32 samePose = dynamic_surface_pose_matches(slot, collisionData);
+    slot->checkedIn = TRUE;
+
+    if (slot->resting) {
+        if (samePose) {
+            return;
+        }
+
+        // The object moved, so its resting surfaces have to go now. Their memory is reclaimed at the next clear.
+        remove_dynamic_surface_nodes(o);
+        slot->resting = FALSE;
+        sRebuildDynamicSurfaces = TRUE;
+    } else if (samePose && !sRebuildDynamicSurfaces) {
+        slot->resting = TRUE;
+        sLoadingRestingSurfaces = TRUE;
+    }
+
+    slot->collisionData = collisionData;
+    vec3f_copy(slot->scale, o->header.gfx.scale);
+    mtxf_copy(slot->transform, o->transform);
+
+    s32 numSurfaces = gSurfacesAllocated;
+    s32 numSurfaceNodes = gSurfaceNodesAllocated;
+
+    load_object_dynamic_surfaces(collisionData);
+
+    if (sLoadingRestingSurfaces) {
+        sNumRestingSurfaces += (gSurfacesAllocated - numSurfaces);
+        sNumRestingSurfaceNodes += (gSurfaceNodesAllocated - numSurfaceNodes);
+        sLoadingRestingSurfaces = FALSE;
+    }
+}
+#endif
+
 /**
  * Transform an object's vertices, reload them, and render the object.
  */
@@ -730,12 +1114,11 @@ void load_object_collision_model(void) {
         && !(o->activeFlags & ACTIVE_FLAG_IN_DIFFERENT_ROOM)
     ) {
         collisionData++;
-        transform_object_vertices(&collisionData, sVertexData);
-
-        // TERRAIN_LOAD_CONTINUE acts as an "end" to the terrain data.
-        while (*collisionData != TERRAIN_LOAD_CONTINUE) {
-            load_object_surfaces(&collisionData, sVertexData, TRUE);
-        }
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+        update_object_dynamic_surfaces(collisionData);
+#else
+        load_object_dynamic_surfaces(collisionData);
+#endif
     }
 
     f32 marioDist = o->oDistanceToMario;
@@ -763,6 +1146,7 @@ void load_object_static_model(void) {
     gCurrStaticSurfacePoolEnd = gCurrStaticSurfacePool;
     gSurfaceNodesAllocated = gNumStaticSurfaceNodes;
     gSurfacesAllocated = gNumStaticSurfaces;
+    gStaticSurfaceLoadCount++;
 
     collisionData++;
     transform_object_vertices(&collisionData, sVertexData);
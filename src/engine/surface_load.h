@@ -38,6 +38,17 @@ extern void *gDynamicSurfacePool;
 extern void *gCurrStaticSurfacePoolEnd;
 extern void *gDynamicSurfacePoolEnd;
 extern u32 gTotalStaticSurfaceData;
+extern u16 gStaticSurfaceLoadCount;
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+extern void *gRestingSurfacePoolStart;
+
+// Resting surfaces fill the dynamic surface pool from the end, so the rest of it can't go past them.
+#define DYNAMIC_SURFACE_POOL_LIMIT gRestingSurfacePoolStart
+
+#define DYNAMIC_SURFACE_SLOT_NONE 0xFF
+#else
+#define DYNAMIC_SURFACE_POOL_LIMIT ((u8 *) gDynamicSurfacePool + DYNAMIC_SURFACE_POOL_SIZE)
+#endif
 
 void alloc_surface_pools(void);
 #ifdef NO_SEGMENTED_MEMORY
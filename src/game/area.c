@@ -7,11 +7,13 @@
 #include "behavior_data.h"
 #include "game_init.h"
 #include "object_list_processor.h"
+#include "engine/surface_collision.h"
 #include "engine/surface_load.h"
 #include "ingame_menu.h"
 #include "screen_transition.h"
 #include "mario.h"
 #include "mario_actions_cutscene.h"
+#include "camera.h"
 #include "print.h"
 #include "hud.h"
 #include "audio/external.h"
@@ -194,6 +196,7 @@ void clear_areas(void) {
         gAreaData[i].graphNode = NULL;
         gAreaData[i].terrainData = NULL;
         gAreaData[i].surfaceRooms = NULL;
+        gAreaData[i].roomVisibility = NULL;
         gAreaData[i].macroObjects = NULL;
         gAreaData[i].warpNodes = NULL;
         gAreaData[i].paintingWarpNodes = NULL;
@@ -214,6 +217,9 @@ void clear_areas(void) {
         gAreaData[i].betterReverbPreset = 0;
 #endif
     }
+
+    // The next level's animations can be loaded where this one's were.
+    anim_pose_cache_invalidate(NULL);
 }
 
 void clear_area_graph_nodes(void) {
@@ -313,6 +319,64 @@ void area_update_objects(void) {
     update_objects(0);
 }
 
+/**
+ * Sets gMarioCurrentRoom to the room Mario is standing in, for areas that don't use geo_switch_area.
+ * Only looks it up once per frame, however many nodes ask for it.
+ */
+void update_mario_current_room(void) {
+    static u32 sLastRoomUpdate = 0;
+
+    if (gMarioObject != NULL && sLastRoomUpdate != gGlobalTimer) {
+        s32 room = get_room_at_pos(gMarioObject->oPosX, gMarioObject->oPosY, gMarioObject->oPosZ);
+
+        if (room > 0) {
+            gMarioCurrentRoom = room;
+        }
+        sLastRoomUpdate = gGlobalTimer;
+    }
+}
+
+/**
+ * Returns the room the camera is in, looked up once per frame. The camera can leave Mario's room, for example
+ * when it's pushed back through a doorway, so rooms have to be visible from both. Returns 0 (everything visible)
+ * when there's no floor below the camera.
+ */
+static s32 get_camera_current_room(void) {
+    static u32 sLastRoomUpdate = 0;
+    static s16 sCameraCurrentRoom = 0;
+
+    if (sLastRoomUpdate != gGlobalTimer) {
+        s32 room = get_room_at_pos(gLakituState.pos[0], gLakituState.pos[1], gLakituState.pos[2]);
+
+        sCameraCurrentRoom = MAX(room, 0);
+        sLastRoomUpdate = gGlobalTimer;
+    }
+
+    return sCameraCurrentRoom;
+}
+
+/**
+ * Returns whether a room can be seen from Mario's room or the camera's, according to the current area's
+ * ROOM_VISIBILITY table. Everything is visible in areas without one, and from or in room 0 and rooms the table
+ * doesn't cover.
+ */
+s32 is_room_visible(s32 room) {
+    const RoomVisibility *visibility = (gCurrentArea != NULL) ? gCurrentArea->roomVisibility : NULL;
+
+    if (visibility == NULL || room <= 0 || room >= (s32) visibility[0]) {
+        return TRUE;
+    }
+
+    s32 cameraRoom = get_camera_current_room();
+
+    if (gMarioCurrentRoom <= 0 || gMarioCurrentRoom >= (s32) visibility[0]
+        || cameraRoom <= 0 || cameraRoom >= (s32) visibility[0]) {
+        return TRUE;
+    }
+
+    return (((visibility[gMarioCurrentRoom] | visibility[cameraRoom]) >> room) & 1);
+}
+
 /*
  * Sets up the information needed to play a warp transition, including the
  * transition type, time in frames, and the RGB color that will fill the screen.
@@ -396,7 +460,9 @@ void render_game(void) {
     PROFILER_GET_SNAPSHOT_TYPE(PROFILER_DELTA_COLLISION);
     if (gCurrentArea != NULL && !gWarpTransition.pauseRendering) {
         if (gCurrentArea->graphNode) {
+            gfx_pool_set_user(GFX_POOL_USER_GRAPH);
             geo_process_root(gCurrentArea->graphNode, gViewportOverride, gViewportClip, gFBSetColor);
+            gfx_pool_set_user(GFX_POOL_USER_OTHER);
         }
 #ifdef PUPPYPRINT
         bzero(gCurrEnvCol, sizeof(ColorRGBA));
@@ -406,13 +472,16 @@ void render_game(void) {
 
         gDPSetScissor(gDisplayListHead++, G_SC_NON_INTERLACE, 0, gBorderHeight, SCREEN_WIDTH,
                       SCREEN_HEIGHT - gBorderHeight);
+        gfx_pool_set_user(GFX_POOL_USER_HUD);
         render_hud();
 
         gDPSetScissor(gDisplayListHead++, G_SC_NON_INTERLACE, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
         render_text_labels();
 #ifdef PUPPYPRINT
+        gfx_pool_set_user(GFX_POOL_USER_PUPPYPRINT);
         puppyprint_print_deferred();
 #endif
+        gfx_pool_set_user(GFX_POOL_USER_OTHER);
         do_cutscene_handler();
         print_displaying_credits_entry();
         gDPSetScissor(gDisplayListHead++, G_SC_NON_INTERLACE, 0, gBorderHeight, SCREEN_WIDTH,
@@ -470,6 +539,8 @@ void render_game(void) {
     profiler_update(PROFILER_TIME_GFX, profiler_get_delta(PROFILER_DELTA_COLLISION) - first);
     profiler_print_times();
 #ifdef PUPPYPRINT_DEBUG
+    gfx_pool_set_user(GFX_POOL_USER_PUPPYPRINT);
     puppyprint_render_profiler();
+    gfx_pool_set_user(GFX_POOL_USER_OTHER);
 #endif
 }
@@ -78,6 +78,7 @@ struct Area {
 #ifdef BETTER_REVERB
     /*0x3C*/ u8 betterReverbPreset;
 #endif
+    const RoomVisibility *roomVisibility; // Which rooms can be seen from each room (set from level script cmd 0x43)
 };
 
 // All the transition data to be used in screen_transition.c
@@ -193,6 +194,8 @@ void load_mario_area(void);
 void unload_mario_area(void);
 void change_area(s32 index);
 void area_update_objects(void);
+void update_mario_current_room(void);
+s32 is_room_visible(s32 room);
 void play_transition(s16 transType, s16 time, u8 red, u8 green, u8 blue);
 void play_transition_after_delay(s16 transType, s16 time, u8 red, u8 green, u8 blue, s16 delay);
 void render_game(void);
@@ -154,7 +154,6 @@ void axotext_revert(void) {
     gDPPipeSync(AXOTEXT_GDL_HEAD++);
     gSPSetGeometryMode(AXOTEXT_GDL_HEAD++, G_ZBUFFER);
     gDPSetTextureFilter(AXOTEXT_GDL_HEAD++, G_TF_BILERP);
-    gDPPipeSync(AXOTEXT_GDL_HEAD++);
     gSPSetGeometryMode(AXOTEXT_GDL_HEAD++, G_LIGHTING);
     gSPClearGeometryMode(AXOTEXT_GDL_HEAD++, G_TEXTURE_GEN);
     gDPSetCombineLERP(
@@ -167,6 +166,8 @@ void axotext_revert(void) {
 
 /**
  * Render all text that has been added to the printing buffer, then reset it.
+ * Only state that actually changes between characters is set again, and the pipe is only synced
+ * before loading a new texture if something has been drawn since the last sync.
  */
 void axotext_render(void) {
     s32 i = 0;
@@ -177,13 +178,24 @@ void axotext_render(void) {
     s32 tileH = 0;
     s32 tileSizeW = 0;
     s32 tileSizeH = 0;
+    s32 filter = -1;
+    s32 drawn = FALSE;
+    u32 primColor = 0;
+    s32 primColorSet = FALSE;
     AxotextFont *font = NULL;
     u8 **textureTable = NULL;
     axotext_setup();
+    gSPTexture(AXOTEXT_GDL_HEAD++, 65535, 65535, 0, 0, 1);
     for (i = 0; i < axotextBufferHeadsIndex; i++) {
         AxotextChar *curChar = axotextBufferHeads[i];
         u8 *texture;
 
+        // Both the texture load and any filter change need the previous characters to be done drawing.
+        if (drawn) {
+            gDPPipeSync(AXOTEXT_GDL_HEAD++);
+            drawn = FALSE;
+        }
+
         if (font != curChar->font) {
             font = curChar->font;
             textureTable = AXOTEXT_SEG_TO_VIRT(font->textureTable);
@@ -196,16 +208,19 @@ void axotext_render(void) {
             tileSizeW = tileW * 2;
             tileSizeH = tileH;
 
-            switch (font->filter) {
-                case AXOTEXT_FILTER_POINT:
-                    gDPSetTextureFilter(AXOTEXT_GDL_HEAD++, G_TF_POINT);
-                    break;
-                case AXOTEXT_FILTER_BILERP:
-                    gDPSetTextureFilter(AXOTEXT_GDL_HEAD++, G_TF_BILERP);
-                    break;
-                case AXOTEXT_FILTER_AVERAGE:
-                    gDPSetTextureFilter(AXOTEXT_GDL_HEAD++, G_TF_AVERAGE);
-                    break;
+            if (filter != font->filter) {
+                filter = font->filter;
+                switch (filter) {
+                    case AXOTEXT_FILTER_POINT:
+                        gDPSetTextureFilter(AXOTEXT_GDL_HEAD++, G_TF_POINT);
+                        break;
+                    case AXOTEXT_FILTER_BILERP:
+                        gDPSetTextureFilter(AXOTEXT_GDL_HEAD++, G_TF_BILERP);
+                        break;
+                    case AXOTEXT_FILTER_AVERAGE:
+                        gDPSetTextureFilter(AXOTEXT_GDL_HEAD++, G_TF_AVERAGE);
+                        break;
+                }
             }
             gSPVertex(AXOTEXT_GDL_HEAD++, axotext_vertex, 4, 0);
             gSPModifyVertex(AXOTEXT_GDL_HEAD++, 0, G_MWO_POINT_ST, t);
@@ -216,8 +231,6 @@ void axotext_render(void) {
 
         if (font != NULL) {
             texture = textureTable[curChar->c];
-            gDPPipeSync(AXOTEXT_GDL_HEAD++);
-            gSPTexture(AXOTEXT_GDL_HEAD++, 65535, 65535, 0, 0, 1);
             gDPSetTextureImage(AXOTEXT_GDL_HEAD++, G_IM_FMT_I, G_IM_SIZ_8b, imageW, texture);
             gDPSetTile(AXOTEXT_GDL_HEAD++, G_IM_FMT_I, G_IM_SIZ_8b, 4, 0, 7, 0, G_TX_WRAP | G_TX_NOMIRROR, 0, 0, G_TX_WRAP | G_TX_NOMIRROR, 0, 0);
             gDPLoadTile(AXOTEXT_GDL_HEAD++, 7, 0, 0, tileW, tileH);
@@ -231,7 +244,13 @@ void axotext_render(void) {
                 s32 modVtxTop    = roundf((AXOTEXT_SCREEN_H - (curChar->y + curChar->h)) * 4.0f);
                 s32 modVtxBottom = roundf((AXOTEXT_SCREEN_H - curChar->y) * 4.0f);
     
-                gDPSetPrimColor(AXOTEXT_GDL_HEAD++, 0, 0, curChar->r, curChar->g, curChar->b, curChar->a);
+                u32 charColor = ((curChar->r << 24) | (curChar->g << 16) | (curChar->b << 8) | curChar->a);
+    
+                if (!primColorSet || charColor != primColor) {
+                    gDPSetPrimColor(AXOTEXT_GDL_HEAD++, 0, 0, curChar->r, curChar->g, curChar->b, curChar->a);
+                    primColor = charColor;
+                    primColorSet = TRUE;
+                }
                 gSPModifyVertex(AXOTEXT_GDL_HEAD++, 0, G_MWO_POINT_XYSCREEN, ((modVtxLeft  << 16) + modVtxBottom));
                 gSPModifyVertex(AXOTEXT_GDL_HEAD++, 1, G_MWO_POINT_XYSCREEN, ((modVtxRight << 16) + modVtxBottom));
                 gSPModifyVertex(AXOTEXT_GDL_HEAD++, 2, G_MWO_POINT_XYSCREEN, ((modVtxRight << 16) + modVtxTop));
@@ -240,6 +259,7 @@ void axotext_render(void) {
     
                 curChar = curChar->next;
             }
+            drawn = TRUE;
         }
     }
     axotextBufferIndex = 0;
@@ -71,7 +71,11 @@ void bhv_yellow_coin_init(void) {
 
 void bhv_yellow_coin_loop(void) {
     bhv_coin_sparkles_init();
+#ifdef OBJECT_TICK_LOD
+    o->oAnimState += o->tickDelta;
+#else
     o->oAnimState++;
+#endif
 }
 
 void bhv_temp_coin_loop(void) {
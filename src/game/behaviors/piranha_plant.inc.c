@@ -23,6 +23,9 @@ void piranha_plant_act_idle(void) {
 
     if (o->oDistanceToMario < 1200.0f) {
         o->oAction = PIRANHA_PLANT_ACT_SLEEPING;
+    } else if (o->oDistanceToMario > OBJECT_SLEEP_WAKE_DIST && o->oDrawingDistance <= OBJECT_SLEEP_WAKE_DIST) {
+        // Nothing happens until Mario comes closer, and it can't be seen from here, so there's no need to keep running.
+        cur_obj_sleep();
     }
 }
 
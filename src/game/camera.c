@@ -1955,7 +1955,6 @@ s16 update_default_camera(struct Camera *c) {
     Vec3f tempPos;
     Vec3f cPos;
     struct Surface *marioFloor;
-    struct Surface *cFloor;
     struct Surface *tempFloor;
     struct Surface *ceil;
     f32 camFloorHeight;
@@ -1977,7 +1976,10 @@ s16 update_default_camera(struct Camera *c) {
     f32 xzDist;
     s16 nextYawVel;
     s16 yawVel = 0;
-    f32 scale;
+    // The floor under the camera, then 5 points along the line to Mario.
+    struct FloorQuery floorQueries[6];
+    s32 numFloorQueries;
+    s32 i;
     s32 avoidStatus = 0;
     s32 closeToMario = FALSE;
     f32 ceilHeight = find_ceil(gLakituState.goalPos[0],
@@ -2140,10 +2142,19 @@ s16 update_default_camera(struct Camera *c) {
 
     marioFloorHeight = 125.f + sMarioGeometry.currFloorHeight;
     marioFloor = sMarioGeometry.currFloor;
-    camFloorHeight = find_floor(cPos[0], cPos[1] + 50.f, cPos[2], &cFloor) + 125.f;
-    for (scale = 0.1f; scale < 1.f; scale += 0.2f) {
-        scale_along_line(tempPos, cPos, sMarioCamState->pos, scale);
-        tempFloorHeight = find_floor(tempPos[0], tempPos[1], tempPos[2], &tempFloor) + 125.f;
+    // Find the floor under the camera and the floors along the line to Mario together, as they're usually in the same cell
+    vec3f_set(floorQueries[0].pos, cPos[0], cPos[1] + 50.f, cPos[2]);
+    for (numFloorQueries = 1; numFloorQueries < (s32) ARRAY_COUNT(floorQueries); numFloorQueries++) {
+        // 0.1, 0.3, 0.5, 0.7 and 0.9 of the way to Mario.
+        f32 scale = (0.2f * numFloorQueries) - 0.1f;
+        scale_along_line(floorQueries[numFloorQueries].pos, cPos, sMarioCamState->pos, scale);
+    }
+    find_floors_batch(floorQueries, numFloorQueries);
+
+    camFloorHeight = floorQueries[0].height + 125.f;
+    for (i = 1; i < numFloorQueries; i++) {
+        tempFloorHeight = floorQueries[i].height + 125.f;
+        tempFloor = floorQueries[i].floor;
         if (tempFloor != NULL && tempFloorHeight > marioFloorHeight) {
             marioFloorHeight = tempFloorHeight;
             marioFloor = tempFloor;
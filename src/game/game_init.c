@@ -31,6 +31,7 @@
 #include "vc_ultra.h"
 #include "profiling.h"
 #include "emutest.h"
+#include "replay.h"
 
 // Emulators that the Instant Input patch should not be applied to
 #define INSTANT_INPUT_BLACKLIST (EMU_CONSOLE | EMU_WIIVC | EMU_ARES | EMU_SIMPLE64 | EMU_CEN64)
@@ -59,7 +60,7 @@ s8 gSramProbe;
 OSMesgQueue gGameVblankQueue;
 OSMesgQueue gGfxVblankQueue;
 OSMesg gGameMesgBuf[1];
-OSMesg gGfxMesgBuf[1];
+OSMesg gGfxMesgBuf[2]; // One per Gfx pool, since a pipelined frame's task can finish before the previous one's message is received.
 
 // Vblank Handler
 struct VblankHandler gGameVblankHandler;
@@ -83,6 +84,9 @@ u8 *gAreaSkyboxEnd[AREA_COUNT];
 u16 sRenderedFramebuffer = 0;
 u16 sRenderingFramebuffer = 0;
 
+// Gfx tasks that have been sent to the RCP, but whose completion message hasn't been received yet
+static u8 sNumGfxTasksInFlight = 0;
+
 // Goddard Vblank Function Caller
 void (*gGoddardVblankCallback)(void) = NULL;
 
@@ -353,6 +357,7 @@ void end_master_display_list(void) {
 
     gDPFullSync(gDisplayListHead++);
     gSPEndDisplayList(gDisplayListHead++);
+    gfx_pool_frame_end();
 
     create_gfx_task_structure();
 }
@@ -400,10 +405,12 @@ void render_init(void) {
     gGfxSPTask = &gGfxPool->spTask;
     gDisplayListHead = gGfxPool->buffer;
     gGfxPoolEnd = (u8 *)(gGfxPool->buffer + GFX_POOL_SIZE);
+    gfx_pool_frame_start();
     init_rcp(CLEAR_ZBUFFER);
     clear_framebuffer(0);
     end_master_display_list();
     exec_display_list(&gGfxPool->spTask);
+    sNumGfxTasksInFlight++;
 
     // Skip incrementing the initial framebuffer index on emulators so that they display immediately as the Gfx task finishes
     // VC probably emulates osViSwapBuffer accurately so instant patch breaks VC compatibility
@@ -423,6 +430,21 @@ void select_gfx_pool(void) {
     gGfxSPTask = &gGfxPool->spTask;
     gDisplayListHead = gGfxPool->buffer;
     gGfxPoolEnd = (u8 *) (gGfxPool->buffer + GFX_POOL_SIZE);
+    gfx_pool_frame_start();
+}
+
+/**
+ * Blocks until no more than maxTasks Gfx tasks are still being run by the RCP.
+ * Once it returns, everything the finished tasks read (their Gfx pool and the framebuffer they drew to) is free to reuse.
+ */
+void wait_for_gfx_tasks(s32 maxTasks) {
+    PROFILER_GET_SNAPSHOT();
+
+    while (sNumGfxTasksInFlight > maxTasks) {
+        osRecvMesg(&gGfxVblankQueue, &gMainReceivedMesg, OS_MESG_BLOCK);
+        sNumGfxTasksInFlight--;
+    }
+    profiler_rcp_wait_update(first);
 }
 
 /**
@@ -433,14 +455,26 @@ void select_gfx_pool(void) {
  * - Selects which framebuffer will be rendered and displayed to next time.
  */
 void display_and_vsync(void) {
-    osRecvMesg(&gGfxVblankQueue, &gMainReceivedMesg, OS_MESG_BLOCK);
+#ifdef GFX_TASK_PIPELINING
+    // Goddard rewrites vertices used by the frame that's about to be sent, so it can't overlap with the previous one.
+    if (gGoddardVblankCallback != NULL) {
+        wait_for_gfx_tasks(0);
+    }
+#else
+    wait_for_gfx_tasks(0);
+#endif
     if (gGoddardVblankCallback != NULL) {
         gGoddardVblankCallback();
         gGoddardVblankCallback = NULL;
     }
     exec_display_list(&gGfxPool->spTask);
+    sNumGfxTasksInFlight++;
 #ifndef UNLOCK_FPS
     osRecvMesg(&gGameVblankQueue, &gMainReceivedMesg, OS_MESG_BLOCK);
+#endif
+#ifdef GFX_TASK_PIPELINING
+    // The previous frame has to be finished before its framebuffer is shown, and before the next frame reuses its Gfx pool.
+    wait_for_gfx_tasks(1);
 #endif
     osViSwapBuffer((void *) PHYSICAL_TO_VIRTUAL(gPhysicalFramebuffers[sRenderedFramebuffer]));
 #ifndef UNLOCK_FPS
@@ -594,6 +628,11 @@ void read_controller_inputs(s32 threadID) {
 #if !defined(DISABLE_DEMO) && defined(KEEP_MARIO_HEAD)
     run_demo_inputs();
 #endif
+#ifdef INPUT_REPLAY
+    if (gPlayer1Controller->controllerData != NULL) {
+        replay_update_inputs(gPlayer1Controller->controllerData);
+    }
+#endif
 
     for (s32 cont = 0; cont < MAX_NUM_PLAYERS; cont++) {
         struct Controller* controller = &gControllers[cont];
@@ -806,8 +845,18 @@ void thread5_game_loop(UNUSED void *arg) {
 #ifdef PUPPYPRINT_DEBUG
         puppyprint_profiler_process();
 #endif
+#ifdef INPUT_REPLAY
+        replay_frame_end();
+#endif
 
-        display_and_vsync();
+        // Headless replays skip the RCP and vsync, and only advance the timer.
+        if (replay_is_headless()) {
+            // Nothing is sent to the RCP, but the next frame may still reuse the Gfx pool of one that's being drawn.
+            wait_for_gfx_tasks(0);
+            gGlobalTimer++;
+        } else {
+            display_and_vsync();
+        }
 #ifdef VANILLA_DEBUG
         // when debug info is enabled, print the "BUF %d" information.
         if (gShowDebugText) {
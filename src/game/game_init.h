@@ -36,7 +36,7 @@ extern OSContPadEx gControllerPads[MAXCONTROLLERS];
 extern OSMesgQueue gGameVblankQueue;
 extern OSMesgQueue gGfxVblankQueue;
 extern OSMesg gGameMesgBuf[1];
-extern OSMesg gGfxMesgBuf[1];
+extern OSMesg gGfxMesgBuf[2];
 extern struct VblankHandler gGameVblankHandler;
 extern uintptr_t gPhysicalFramebuffers[3];
 extern uintptr_t gPhysicalZBuffer;
@@ -89,6 +89,7 @@ void init_rcp(s32 resetZB);
 void end_master_display_list(void);
 void render_init(void);
 void select_gfx_pool(void);
+void wait_for_gfx_tasks(s32 maxTasks);
 void display_and_vsync(void);
 
 #endif // GAME_INIT_H
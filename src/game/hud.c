@@ -605,8 +605,10 @@ void render_hud(void) {
                 0,
                 128
             };
+            GFX_POOL_PUSH_USER(GFX_POOL_USER_AXOTEXT);
             axotext_print(160, 40, &params, -1, "Thanks for trying out axotext\n<3");
             axotext_render();
+            GFX_POOL_POP_USER();
         }
 
 #ifdef VANILLA_STYLE_CUSTOM_DEBUG
@@ -96,6 +96,31 @@ static struct InteractionHandler sInteractionHandlers[] = {
     { INTERACT_TEXT,           interact_text },
 };
 
+/**
+ * For each interact type bit, its handler's position in sInteractionHandlers plus one, or 0 if it doesn't have one.
+ * Lets mario_process_interactions visit only the handlers that have a collided object, still in priority order.
+ */
+static u8 sInteractionHandlerRanks[32];
+static u8 sInteractionHandlerRanksBuilt = FALSE;
+
+/**
+ * Returns which bit is set in a value with exactly one bit set, using a de Bruijn sequence.
+ */
+static s32 get_single_bit_index(u32 bit) {
+    static const u8 sDeBruijnBitIndices[32] = {
+         0,  1, 28,  2, 29, 14, 24,  3, 30, 22, 20, 15, 25, 17,  4,  8,
+        31, 27, 13, 23, 21, 19, 16,  7, 26, 12, 18,  6, 11,  5, 10,  9,
+    };
+    return sDeBruijnBitIndices[(bit * 0x077CB531) >> 27];
+}
+
+static void build_interaction_handler_ranks(void) {
+    for (s32 i = 0; i < ARRAY_COUNT(sInteractionHandlers); i++) {
+        sInteractionHandlerRanks[get_single_bit_index(sInteractionHandlers[i].interactType)] = (i + 1);
+    }
+    sInteractionHandlerRanksBuilt = TRUE;
+}
+
 static u32 sForwardKnockbackActions[][3] = {
 //    Soft                        Normal                 Hard
     { ACT_SOFT_FORWARD_GROUND_KB, ACT_FORWARD_GROUND_KB, ACT_HARD_FORWARD_GROUND_KB }, // Ground
@@ -1824,9 +1849,30 @@ void mario_process_interactions(struct MarioState *m) {
     sInvulnerable = (m->action & ACT_FLAG_INVULNERABLE) || m->invincTimer != 0;
 
     if (!(m->action & ACT_FLAG_INTANGIBLE) && m->collidedObjInteractTypes != 0) {
-        s32 i;
-        for (i = 0; i < ARRAY_COUNT(sInteractionHandlers); i++) {
+        u32 types = m->collidedObjInteractTypes;
+        u32 pendingHandlers = 0;
+
+        if (!sInteractionHandlerRanksBuilt) {
+            build_interaction_handler_ranks();
+        }
+
+        // Bit i of pendingHandlers is set if sInteractionHandlers[i] has a collided object, so taking
+        // the lowest bit each time visits them in the same order as walking the whole table.
+        while (types != 0) {
+            u32 bit = (types & -types);
+            s32 rank = sInteractionHandlerRanks[get_single_bit_index(bit)];
+            if (rank != 0) {
+                pendingHandlers |= (1 << (rank - 1));
+            }
+            types ^= bit;
+        }
+
+        while (pendingHandlers != 0) {
+            u32 handlerBit = (pendingHandlers & -pendingHandlers);
+            s32 i = get_single_bit_index(handlerBit);
             u32 interactType = sInteractionHandlers[i].interactType;
+            pendingHandlers ^= handlerBit;
+
             if (m->collidedObjInteractTypes & interactType) {
                 struct Object *object = mario_get_collided_object(m, interactType);
 
@@ -7,6 +7,7 @@
 #include "engine/math_util.h"
 #include "camera.h"
 #include "envfx_snow.h"
+#include "puppyprint.h"
 #include "level_geo.h"
 
 /**
@@ -27,6 +28,7 @@ Gfx *geo_envfx_main(s32 callContext, struct GraphNode *node, Mat4 mtxf) {
 
         if (GET_HIGH_U16_OF_32(*params) != gAreaUpdateCounter) {
             s32 snowMode = GET_LOW_U16_OF_32(*params);
+            GFX_POOL_PUSH_USER(GFX_POOL_USER_ENVFX);
 
             vec3f_to_vec3s(camTo, gCurGraphNodeCamera->focus);
             vec3f_to_vec3s(camFrom, gCurGraphNodeCamera->pos);
@@ -41,6 +43,7 @@ Gfx *geo_envfx_main(s32 callContext, struct GraphNode *node, Mat4 mtxf) {
                 gSPBranchList(&gfx[1], VIRTUAL_TO_PHYSICAL(particleList));
                 SET_GRAPH_NODE_LAYER(execNode->fnNode.node.flags, LAYER_OCCLUDE_SILHOUETTE_ALPHA);
             }
+            GFX_POOL_POP_USER();
             SET_HIGH_U16_OF_32(*params, gAreaUpdateCounter);
         }
     } else if (callContext == GEO_CONTEXT_AREA_INIT) {
@@ -32,6 +32,7 @@
 #include "puppyprint.h"
 #include "puppylights.h"
 #include "level_commands.h"
+#include "replay.h"
 
 #include "config.h"
 
@@ -1322,6 +1323,10 @@ s32 init_level(void) {
     puppylights_allocate();
 #endif
 
+#ifdef INPUT_REPLAY
+    replay_level_loaded();
+#endif
+
     append_puppyprint_log("Level loaded in %d" PP_CYCLE_STRING ".", (s32)(PP_CYCLE_CONV(osGetTime() - first)));
     return TRUE;
 }
@@ -4,6 +4,7 @@
 #include "object_helpers.h"
 #include "macro_special_objects.h"
 #include "object_list_processor.h"
+#include "puppyprint.h"
 
 #include "behavior_data.h"
 
@@ -26,6 +27,38 @@ s32 convert_rotation(s16 inRotation) {
     return (s16) rotation;
 }
 
+/*
+ * Index into SpecialObjectPresets for every preset ID, so that spawning a special object
+ * doesn't have to search the table. Built the first time a special object list is loaded.
+ */
+static u8 sSpecialPresetIndices[0x100];
+static u8 sSpecialPresetIndicesBuilt = FALSE;
+
+static struct SpecialPreset *get_special_preset(u8 presetID) {
+    if (!sSpecialPresetIndicesBuilt) {
+        // Unknown preset IDs fall back to the first preset.
+        for (s32 i = (ARRAY_COUNT(SpecialObjectPresets) - 1); i >= 0; i--) {
+            sSpecialPresetIndices[SpecialObjectPresets[i].preset_id] = i;
+        }
+        sSpecialPresetIndicesBuilt = TRUE;
+    }
+
+    return &SpecialObjectPresets[sSpecialPresetIndices[presetID]];
+}
+
+/*
+ * Holds back an object's first behavior update until Mario is within its drawing distance, and hides it until then.
+ * Only used for objects that are known to do nothing but set themselves up on their first frame.
+ */
+static void defer_object_init(struct Object *obj) {
+#ifdef OBJECT_TICK_LOD
+    if (obj->behavior == segmented_to_virtual(bhvYellowCoin) || obj->behavior == segmented_to_virtual(bhvOneCoin)) {
+        obj->activeFlags |= ACTIVE_FLAG_DEFERRED_INIT;
+        obj->header.gfx.node.flags &= ~GRAPH_RENDER_ACTIVE;
+    }
+#endif
+}
+
 /*
  * Spawns an object at an absolute location with rotation around the y-axis and
  * parameters filling up the upper 2 bytes of newObj->oBehParams.
@@ -36,6 +69,7 @@ void spawn_macro_abs_yrot_2params(ModelID32 model, const BehaviorScript *behavio
         struct Object *newObj =
             spawn_object_abs_with_rot(&gMacroObjectDefaultParent, 0, model, behavior, x, y, z, 0, convert_rotation(ry), 0);
         newObj->oBehParams = ((u32) params) << 16;
+        defer_object_init(newObj);
     }
 }
 
@@ -88,6 +122,10 @@ void spawn_macro_objects(s32 areaIndex, MacroObject *macroObjList) {
     struct LoadedMacroObject macroObject;
     struct Object *newObj;
     struct MacroPreset preset;
+#ifdef PUPPYPRINT_DEBUG
+    OSTime first = osGetTime();
+    s32 numSpawned = 0;
+#endif
 
     gMacroObjectDefaultParent.header.gfx.areaIndex = areaIndex;
     gMacroObjectDefaultParent.header.gfx.activeAreaIndex = areaIndex;
@@ -142,8 +180,14 @@ void spawn_macro_objects(s32 areaIndex, MacroObject *macroObjList) {
             newObj->respawnInfoType = RESPAWN_INFO_TYPE_MACRO_OBJECT;
             newObj->respawnInfo = macroObjList - 1;
             newObj->parentObj = newObj;
+            defer_object_init(newObj);
+#ifdef PUPPYPRINT_DEBUG
+            numSpawned++;
+#endif
         }
     }
+
+    append_puppyprint_log("%d macro objects spawned in %d" PP_CYCLE_STRING ".", numSpawned, (s32)(PP_CYCLE_CONV(osGetTime() - first)));
 }
 
 void spawn_macro_objects_hardcoded(s32 areaIndex, MacroObject *macroObjList) {
@@ -185,7 +229,6 @@ void spawn_macro_objects_hardcoded(s32 areaIndex, MacroObject *macroObjList) {
 
 void spawn_special_objects(s32 areaIndex, TerrainData **specialObjList) {
     s32 i;
-    s32 offset;
     Vec3s pos;
     s16 extraParams[4];
     ModelID16 model;
@@ -193,6 +236,10 @@ void spawn_special_objects(s32 areaIndex, TerrainData **specialObjList) {
     u8 presetID;
     u8 defaultParam;
     const BehaviorScript *behavior;
+    struct SpecialPreset *preset;
+#ifdef PUPPYPRINT_DEBUG
+    OSTime first = osGetTime();
+#endif
 
     s32 numOfSpecialObjects = *(*specialObjList)++;
 
@@ -205,18 +252,11 @@ void spawn_special_objects(s32 areaIndex, TerrainData **specialObjList) {
         pos[1]   = *(*specialObjList)++;
         pos[2]   = *(*specialObjList)++;
 
-        offset = 0;
-        while (TRUE) {
-            if (SpecialObjectPresets[offset].preset_id == presetID) {
-                break;
-            }
-            offset++;
-        }
-
-        model = SpecialObjectPresets[offset].model;
-        behavior = SpecialObjectPresets[offset].behavior;
-        type = SpecialObjectPresets[offset].type;
-        defaultParam = SpecialObjectPresets[offset].defParam;
+        preset = get_special_preset(presetID);
+        model = preset->model;
+        behavior = preset->behavior;
+        type = preset->type;
+        defaultParam = preset->defParam;
 
         switch (type) {
             case SPTYPE_NO_YROT_OR_PARAMS:
@@ -245,6 +285,8 @@ void spawn_special_objects(s32 areaIndex, TerrainData **specialObjList) {
                 break;
         }
     }
+
+    append_puppyprint_log("%d special objects spawned in %d" PP_CYCLE_STRING ".", numOfSpecialObjects, (s32)(PP_CYCLE_CONV(osGetTime() - first)));
 }
 
 #ifdef NO_SEGMENTED_MEMORY
@@ -252,23 +294,14 @@ u32 get_special_objects_size(s16 *data) {
     s16 *startPos = data;
     s32 i;
     u8 presetID;
-    s32 offset;
 
     s32 numOfSpecialObjects = *data++;
 
     for (i = 0; i < numOfSpecialObjects; i++) {
         presetID = (u8) *data++;
         data += 3;
-        offset = 0;
-
-        while (TRUE) {
-            if (SpecialObjectPresets[offset].preset_id == presetID) {
-                break;
-            }
-            offset++;
-        }
 
-        switch (SpecialObjectPresets[offset].type) {
+        switch (get_special_preset(presetID)->type) {
             case SPTYPE_NO_YROT_OR_PARAMS:
                 break;
             case SPTYPE_YROT_NO_PARAMS:
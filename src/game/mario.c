@@ -29,6 +29,7 @@
 #include "object_helpers.h"
 #include "object_list_processor.h"
 #include "print.h"
+#include "rendering_graph_node.h"
 #include "save_file.h"
 #include "sound_init.h"
 #include "rumble_init.h"
@@ -66,6 +67,7 @@ s16 set_mario_animation(struct MarioState *m, s32 targetAnimID) {
     if (load_patchable_table(m->animList, targetAnimID)) {
         targetAnim->values = (void *) VIRTUAL_TO_PHYSICAL((u8 *) targetAnim + (uintptr_t) targetAnim->values);
         targetAnim->index  = (void *) VIRTUAL_TO_PHYSICAL((u8 *) targetAnim + (uintptr_t) targetAnim->index);
+        anim_pose_cache_invalidate(targetAnim);
     }
 
     if (marioObj->header.gfx.animInfo.animID != targetAnimID) {
@@ -99,6 +101,7 @@ s16 set_mario_anim_with_accel(struct MarioState *m, s32 targetAnimID, s32 accel)
     if (load_patchable_table(m->animList, targetAnimID)) {
         targetAnim->values = (void *) VIRTUAL_TO_PHYSICAL((u8 *) targetAnim + (uintptr_t) targetAnim->values);
         targetAnim->index = (void *) VIRTUAL_TO_PHYSICAL((u8 *) targetAnim + (uintptr_t) targetAnim->index);
+        anim_pose_cache_invalidate(targetAnim);
     }
 
     if (marioObj->header.gfx.animInfo.animID != targetAnimID) {
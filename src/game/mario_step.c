@@ -344,15 +344,43 @@ static s32 perform_ground_quarter_step(struct MarioState *m, Vec3f nextPos) {
     return GROUND_STEP_NONE;
 }
 
+#ifdef SWEPT_WALL_COLLISION
+/**
+ * Sweep Mario's lower and upper wall checks along his movement to decide how many steps it should be split into.
+ * Returns 1 if nothing is in the way. Otherwise, the movement is split into at least the vanilla four steps, and
+ * more if needed to keep each step shorter than the smaller wall radius, so no wall can be skipped over.
+ * There's no upper limit, as any cap would bring back clipping above some speed.
+ */
+static s32 get_num_steps_from_sweep(Vec3f pos, Vec3f displacement, f32 lowerOffset, f32 lowerRadius, f32 upperOffset, f32 upperRadius) {
+    Vec3f endPos;
+    vec3f_sum(endPos, pos, displacement);
+
+    if (find_wall_sweep(pos, endPos, lowerOffset, lowerRadius, NULL) >= 1.0f
+        && find_wall_sweep(pos, endPos, upperOffset, upperRadius, NULL) >= 1.0f) {
+        return 1;
+    }
+
+    f32 numSteps = sqrtf(sqr(displacement[0]) + sqr(displacement[2])) / MIN(lowerRadius, upperRadius);
+    s32 steps = (s32) numSteps + 1;
+
+    return MAX(steps, 4);
+}
+#endif
+
 s32 perform_ground_step(struct MarioState *m) {
     s32 i;
     u32 stepResult;
     Vec3f intendedPos;
-    const f32 numSteps = 4.0f;
+#ifdef SWEPT_WALL_COLLISION
+    Vec3f displacement = { m->floor->normal.y * m->vel[0], 0.0f, m->floor->normal.y * m->vel[2] };
+    const s32 numSteps = get_num_steps_from_sweep(m->pos, displacement, 30.0f, 24.0f, 60.0f, 50.0f);
+#else
+    const s32 numSteps = 4;
+#endif
 
     set_mario_wall(m, NULL);
 
-    for (i = 0; i < 4; i++) {
+    for (i = 0; i < numSteps; i++) {
         intendedPos[0] = m->pos[0] + m->floor->normal.y * (m->vel[0] / numSteps);
         intendedPos[2] = m->pos[2] + m->floor->normal.y * (m->vel[2] / numSteps);
         intendedPos[1] = m->pos[1];
@@ -680,14 +708,18 @@ void apply_vertical_wind(struct MarioState *m) {
 
 s32 perform_air_step(struct MarioState *m, u32 stepArg) {
     Vec3f intendedPos;
-    const f32 numSteps = 4.0f;
+#ifdef SWEPT_WALL_COLLISION
+    const s32 numSteps = get_num_steps_from_sweep(m->pos, m->vel, 30.0f, 50.0f, 150.0f, 50.0f);
+#else
+    const s32 numSteps = 4;
+#endif
     s32 i;
     s32 quarterStepResult;
     s32 stepResult = AIR_STEP_NONE;
 
     set_mario_wall(m, NULL);
 
-    for (i = 0; i < 4; i++) {
+    for (i = 0; i < numSteps; i++) {
         intendedPos[0] = m->pos[0] + m->vel[0] / numSteps;
         intendedPos[1] = m->pos[1] + m->vel[1] / numSteps;
         intendedPos[2] = m->pos[2] + m->vel[2] / numSteps;
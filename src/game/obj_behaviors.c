@@ -392,7 +392,7 @@ s16 object_step(void) {
         collisionFlags += OBJ_COL_FLAG_HIT_WALL;
     }
 
-    floorY = find_floor(objX + objVelX, objY, objZ + objVelZ, &sObjFloor);
+    floorY = cur_obj_find_floor(objX + objVelX, objY, objZ + objVelZ, &sObjFloor);
 
     o->oFloor       = sObjFloor;
     o->oFloorHeight = floorY;
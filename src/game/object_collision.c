@@ -8,6 +8,9 @@
 #include "spawn_object.h"
 #include "engine/math_util.h"
 
+#include "config.h"
+#include "config/config_world.h"
+
 UNUSED struct Object *debug_print_obj_collision(struct Object *a) {
     struct Object *currCollidedObj;
     s32 i;
@@ -22,17 +25,40 @@ UNUSED struct Object *debug_print_obj_collision(struct Object *a) {
     return NULL;
 }
 
+/**
+ * The fields that collision detection reads, packed into arrays indexed by object pool slot. They're copied out
+ * of every object in the collision lists by clear_object_collision, which already has to touch each object
+ * every frame, so the pair tests after it don't have to pull in each object's whole struct.
+ * Objects can be moved by other objects after their own behavior runs, so these are only valid during
+ * detect_object_collisions.
+ */
+struct ObjectCollisionFields {
+    f32 posX[OBJECT_POOL_CAPACITY];
+    f32 posZ[OBJECT_POOL_CAPACITY];
+    f32 bottom[OBJECT_POOL_CAPACITY]; // oPosY - hitboxDownOffset
+    f32 hitboxRadius[OBJECT_POOL_CAPACITY];
+    f32 hitboxHeight[OBJECT_POOL_CAPACITY];
+    f32 hurtboxRadius[OBJECT_POOL_CAPACITY];
+    f32 hurtboxHeight[OBJECT_POOL_CAPACITY];
+};
+
+static struct ObjectCollisionFields sCollisionFields;
+
+#define OBJ_POOL_SLOT(obj) ((obj) - gObjectPool)
+
 s32 detect_object_hitbox_overlap(struct Object *a, struct Object *b) {
-    f32 dya_bottom = a->oPosY - a->hitboxDownOffset;
-    f32 dyb_bottom = b->oPosY - b->hitboxDownOffset;
-    f32 dx = a->oPosX - b->oPosX;
-    f32 dz = a->oPosZ - b->oPosZ;
-    f32 collisionRadius = a->hitboxRadius + b->hitboxRadius;
+    s32 ai = OBJ_POOL_SLOT(a);
+    s32 bi = OBJ_POOL_SLOT(b);
+    f32 dya_bottom = sCollisionFields.bottom[ai];
+    f32 dyb_bottom = sCollisionFields.bottom[bi];
+    f32 dx = sCollisionFields.posX[ai] - sCollisionFields.posX[bi];
+    f32 dz = sCollisionFields.posZ[ai] - sCollisionFields.posZ[bi];
+    f32 collisionRadius = sCollisionFields.hitboxRadius[ai] + sCollisionFields.hitboxRadius[bi];
     f32 distance = sqr(dx) + sqr(dz);
 
     if (sqr(collisionRadius) > distance) {
-        f32 dya_top = a->hitboxHeight + dya_bottom;
-        f32 dyb_top = b->hitboxHeight + dyb_bottom;
+        f32 dya_top = sCollisionFields.hitboxHeight[ai] + dya_bottom;
+        f32 dyb_top = sCollisionFields.hitboxHeight[bi] + dyb_bottom;
 
         if (dya_bottom > dyb_top
             || dya_top < dyb_bottom
@@ -53,11 +79,13 @@ s32 detect_object_hitbox_overlap(struct Object *a, struct Object *b) {
 }
 
 s32 detect_object_hurtbox_overlap(struct Object *a, struct Object *b) {
-    f32 dya_bottom = a->oPosY - a->hitboxDownOffset;
-    f32 dyb_bottom = b->oPosY - b->hitboxDownOffset;
-    f32 dx = a->oPosX - b->oPosX;
-    f32 dz = a->oPosZ - b->oPosZ;
-    f32 collisionRadius = a->hurtboxRadius + b->hurtboxRadius;
+    s32 ai = OBJ_POOL_SLOT(a);
+    s32 bi = OBJ_POOL_SLOT(b);
+    f32 dya_bottom = sCollisionFields.bottom[ai];
+    f32 dyb_bottom = sCollisionFields.bottom[bi];
+    f32 dx = sCollisionFields.posX[ai] - sCollisionFields.posX[bi];
+    f32 dz = sCollisionFields.posZ[ai] - sCollisionFields.posZ[bi];
+    f32 collisionRadius = sCollisionFields.hurtboxRadius[ai] + sCollisionFields.hurtboxRadius[bi];
     f32 distance = sqr(dx) + sqr(dz);
 
     if (a == gMarioObject) {
@@ -65,8 +93,8 @@ s32 detect_object_hurtbox_overlap(struct Object *a, struct Object *b) {
     }
 
     if (sqr(collisionRadius) > distance) {
-        f32 dya_top = a->hitboxHeight  + dya_bottom;
-        f32 dyb_top = b->hurtboxHeight + dyb_bottom;
+        f32 dya_top = sCollisionFields.hitboxHeight[ai]  + dya_bottom;
+        f32 dyb_top = sCollisionFields.hurtboxHeight[bi] + dyb_bottom;
 
         if (dya_bottom > dyb_top || dya_top < dyb_bottom) {
             return FALSE;
@@ -80,15 +108,239 @@ s32 detect_object_hurtbox_overlap(struct Object *a, struct Object *b) {
     return FALSE;
 }
 
-void clear_object_collision(struct Object *a) {
-    struct Object *nextObj = (struct Object *) a->header.next;
+#ifdef OBJECT_COLLISION_BROADPHASE
+/**
+ * A uniform grid over the level that every tangible object in the collision lists is added to each frame,
+ * in every cell its hitbox overlaps. Only objects that share a cell can have overlapping hitboxes, so each
+ * object is only tested against the objects in its own cells.
+ */
+#define BROADPHASE_GRID_SIZE   32
+#define BROADPHASE_CELL_SIZE   ((2 * LEVEL_BOUNDARY_MAX) / BROADPHASE_GRID_SIZE)
+#define BROADPHASE_MAX_ENTRIES (OBJECT_POOL_CAPACITY * 4)
+
+struct BroadphaseEntry {
+    s16 objIndex; // Index into gObjectPool.
+    s16 next;     // Next entry in the same cell, or -1.
+    s16 cell;     // The cell this entry was added to, so it can be cleared again.
+};
+
+static s16 sBroadphaseCells[BROADPHASE_GRID_SIZE * BROADPHASE_GRID_SIZE];
+static struct BroadphaseEntry sBroadphaseEntries[BROADPHASE_MAX_ENTRIES];
+static s32 sNumBroadphaseEntries;
+
+// Per object pool slot: the list the object is in, its position in that list, and the last query it was found by.
+static u8  sBroadphaseList[OBJECT_POOL_CAPACITY];
+static u16 sBroadphaseOrder[OBJECT_POOL_CAPACITY];
+static u16 sBroadphaseQuery[OBJECT_POOL_CAPACITY];
+static u16 sBroadphaseQueryID;
+
+// Whether the grid holds every object this frame. If too many cells were used, every pair is tested instead.
+static u8 sBroadphaseValid;
+
+static struct Object *sBroadphaseCandidates[OBJECT_POOL_CAPACITY];
+static u32 sBroadphaseCandidateKeys[OBJECT_POOL_CAPACITY];
+
+// The order that each kind of object checks the lists in, matching check_*_object_collision. -1 for lists that aren't checked.
+static const s8 sPlayerListPriority[NUM_OBJ_LISTS] = {
+    [OBJ_LIST_PLAYER     ] =  0,
+    [OBJ_LIST_UNUSED_1   ] = -1,
+    [OBJ_LIST_DESTRUCTIVE] =  6,
+    [OBJ_LIST_UNUSED_3   ] = -1,
+    [OBJ_LIST_GENACTOR   ] =  3,
+    [OBJ_LIST_PUSHABLE   ] =  4,
+    [OBJ_LIST_LEVEL      ] =  2,
+    [OBJ_LIST_UNUSED_7   ] = -1,
+    [OBJ_LIST_DEFAULT    ] = -1,
+    [OBJ_LIST_SURFACE    ] =  5,
+    [OBJ_LIST_POLELIKE   ] =  1,
+    [OBJ_LIST_SPAWNER    ] = -1,
+    [OBJ_LIST_UNIMPORTANT] = -1,
+};
+static const s8 sDestructiveListPriority[NUM_OBJ_LISTS] = {
+    [OBJ_LIST_PLAYER     ] = -1,
+    [OBJ_LIST_UNUSED_1   ] = -1,
+    [OBJ_LIST_DESTRUCTIVE] =  0,
+    [OBJ_LIST_UNUSED_3   ] = -1,
+    [OBJ_LIST_GENACTOR   ] =  1,
+    [OBJ_LIST_PUSHABLE   ] =  2,
+    [OBJ_LIST_LEVEL      ] = -1,
+    [OBJ_LIST_UNUSED_7   ] = -1,
+    [OBJ_LIST_DEFAULT    ] = -1,
+    [OBJ_LIST_SURFACE    ] =  3,
+    [OBJ_LIST_POLELIKE   ] = -1,
+    [OBJ_LIST_SPAWNER    ] = -1,
+    [OBJ_LIST_UNIMPORTANT] = -1,
+};
+static const s8 sPushableListPriority[NUM_OBJ_LISTS] = {
+    [OBJ_LIST_PLAYER     ] = -1,
+    [OBJ_LIST_UNUSED_1   ] = -1,
+    [OBJ_LIST_DESTRUCTIVE] = -1,
+    [OBJ_LIST_UNUSED_3   ] = -1,
+    [OBJ_LIST_GENACTOR   ] = -1,
+    [OBJ_LIST_PUSHABLE   ] =  0,
+    [OBJ_LIST_LEVEL      ] = -1,
+    [OBJ_LIST_UNUSED_7   ] = -1,
+    [OBJ_LIST_DEFAULT    ] = -1,
+    [OBJ_LIST_SURFACE    ] = -1,
+    [OBJ_LIST_POLELIKE   ] = -1,
+    [OBJ_LIST_SPAWNER    ] = -1,
+    [OBJ_LIST_UNIMPORTANT] = -1,
+};
+
+static s32 get_broadphase_cell_coord(f32 coord) {
+    s32 cell = (s32)(coord + LEVEL_BOUNDARY_MAX) / BROADPHASE_CELL_SIZE;
+    return CLAMP(cell, 0, (BROADPHASE_GRID_SIZE - 1));
+}
+
+/**
+ * Add an object to every grid cell its hitbox overlaps.
+ */
+static void add_object_to_broadphase(s32 objIndex) {
+    f32 radius = sCollisionFields.hitboxRadius[objIndex];
+    s32 minCellX = get_broadphase_cell_coord(sCollisionFields.posX[objIndex] - radius);
+    s32 maxCellX = get_broadphase_cell_coord(sCollisionFields.posX[objIndex] + radius);
+    s32 minCellZ = get_broadphase_cell_coord(sCollisionFields.posZ[objIndex] - radius);
+    s32 maxCellZ = get_broadphase_cell_coord(sCollisionFields.posZ[objIndex] + radius);
+
+    for (s32 cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+        for (s32 cellX = minCellX; cellX <= maxCellX; cellX++) {
+            if (sNumBroadphaseEntries >= BROADPHASE_MAX_ENTRIES) {
+                sBroadphaseValid = FALSE;
+                return;
+            }
+
+            s32 cell = ((cellZ * BROADPHASE_GRID_SIZE) + cellX);
+            struct BroadphaseEntry *entry = &sBroadphaseEntries[sNumBroadphaseEntries];
+            entry->objIndex = objIndex;
+            entry->next = sBroadphaseCells[cell];
+            entry->cell = cell;
+            sBroadphaseCells[cell] = sNumBroadphaseEntries++;
+        }
+    }
+}
+
+/**
+ * Empty the grid from last frame, ready for clear_object_collision to add this frame's objects to it.
+ */
+static void clear_broadphase(void) {
+    s32 i;
+
+    if (sNumBroadphaseEntries == 0) {
+        // Nothing was added last frame, or this is the first frame, so clear everything.
+        for (i = 0; i < (BROADPHASE_GRID_SIZE * BROADPHASE_GRID_SIZE); i++) {
+            sBroadphaseCells[i] = -1;
+        }
+    } else {
+        for (i = 0; i < sNumBroadphaseEntries; i++) {
+            sBroadphaseCells[sBroadphaseEntries[i].cell] = -1;
+        }
+    }
+
+    sNumBroadphaseEntries = 0;
+    sBroadphaseValid = TRUE;
+}
+
+/**
+ * Test an object against every object that shares a grid cell with it, from the lists given by listPriority.
+ * Objects are tested in the same order the lists would be walked in, so which objects fill the 4 collision
+ * slots doesn't change. Objects in the same list as 'a' are only tested if they come after it.
+ */
+static void check_collision_in_broadphase(struct Object *a, const s8 *listPriority) {
+    s32 aIndex = OBJ_POOL_SLOT(a);
+    s32 aList = sBroadphaseList[aIndex];
+    s32 numCandidates = 0;
+    s32 i, j;
+
+    if (a->oIntangibleTimer != 0) {
+        return;
+    }
+
+    if (++sBroadphaseQueryID == 0) {
+        // The IDs wrapped around, so make sure no object looks like it was already found by this query.
+        bzero(sBroadphaseQuery, sizeof(sBroadphaseQuery));
+        sBroadphaseQueryID = 1;
+    }
+
+    sBroadphaseQuery[aIndex] = sBroadphaseQueryID;
+
+    f32 radius = sCollisionFields.hitboxRadius[aIndex];
+    s32 minCellX = get_broadphase_cell_coord(sCollisionFields.posX[aIndex] - radius);
+    s32 maxCellX = get_broadphase_cell_coord(sCollisionFields.posX[aIndex] + radius);
+    s32 minCellZ = get_broadphase_cell_coord(sCollisionFields.posZ[aIndex] - radius);
+    s32 maxCellZ = get_broadphase_cell_coord(sCollisionFields.posZ[aIndex] + radius);
+
+    for (s32 cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+        for (s32 cellX = minCellX; cellX <= maxCellX; cellX++) {
+            s32 entryIndex = sBroadphaseCells[(cellZ * BROADPHASE_GRID_SIZE) + cellX];
+
+            for (; entryIndex != -1; entryIndex = sBroadphaseEntries[entryIndex].next) {
+                s32 bIndex = sBroadphaseEntries[entryIndex].objIndex;
+
+                if (sBroadphaseQuery[bIndex] == sBroadphaseQueryID) continue;
+                sBroadphaseQuery[bIndex] = sBroadphaseQueryID;
+
+                s32 bList = sBroadphaseList[bIndex];
+                s32 priority = listPriority[bList];
+                if (priority < 0) continue;
+                if ((bList == aList) && (sBroadphaseOrder[bIndex] < sBroadphaseOrder[aIndex])) continue;
+
+                // Insertion sort by list priority, then position in the list.
+                u32 key = ((priority << 16) | sBroadphaseOrder[bIndex]);
+                for (j = numCandidates; (j > 0) && (sBroadphaseCandidateKeys[j - 1] > key); j--) {
+                    sBroadphaseCandidates[j] = sBroadphaseCandidates[j - 1];
+                    sBroadphaseCandidateKeys[j] = sBroadphaseCandidateKeys[j - 1];
+                }
+                sBroadphaseCandidates[j] = &gObjectPool[bIndex];
+                sBroadphaseCandidateKeys[j] = key;
+                numCandidates++;
+            }
+        }
+    }
+
+    for (i = 0; i < numCandidates; i++) {
+        struct Object *b = sBroadphaseCandidates[i];
+
+        if (detect_object_hitbox_overlap(a, b) && b->hurtboxRadius != 0.0f) {
+            detect_object_hurtbox_overlap(a, b);
+        }
+    }
+}
+#endif
+
+void clear_object_collision(s32 listIndex) {
+    struct Object *listHead = (struct Object *) &gObjectLists[listIndex];
+    struct Object *nextObj = (struct Object *) listHead->header.next;
+#ifdef OBJECT_COLLISION_BROADPHASE
+    u16 order = 0;
+#endif
+
+    while (nextObj != listHead) {
+        s32 objIndex = OBJ_POOL_SLOT(nextObj);
 
-    while (nextObj != a) {
         nextObj->numCollidedObjs = 0;
         nextObj->collidedObjInteractTypes = 0;
         if (nextObj->oIntangibleTimer > 0) {
             nextObj->oIntangibleTimer--;
         }
+
+        sCollisionFields.posX[objIndex]          = nextObj->oPosX;
+        sCollisionFields.posZ[objIndex]          = nextObj->oPosZ;
+        sCollisionFields.bottom[objIndex]        = nextObj->oPosY - nextObj->hitboxDownOffset;
+        sCollisionFields.hitboxRadius[objIndex]  = nextObj->hitboxRadius;
+        sCollisionFields.hitboxHeight[objIndex]  = nextObj->hitboxHeight;
+        sCollisionFields.hurtboxRadius[objIndex] = nextObj->hurtboxRadius;
+        sCollisionFields.hurtboxHeight[objIndex] = nextObj->hurtboxHeight;
+
+#ifdef OBJECT_COLLISION_BROADPHASE
+        sBroadphaseList[objIndex] = listIndex;
+        sBroadphaseOrder[objIndex] = order++;
+
+        // Intangible objects are skipped by check_collision_in_list anyway.
+        if (nextObj->oIntangibleTimer == 0) {
+            add_object_to_broadphase(objIndex);
+        }
+#endif
+
         nextObj = (struct Object *) nextObj->header.next;
     }
 }
@@ -111,6 +363,13 @@ void check_player_object_collision(void) {
     struct Object   *nextObj = (struct Object *) playerObj->header.next;
 
     while (nextObj != playerObj) {
+#ifdef OBJECT_COLLISION_BROADPHASE
+        if (sBroadphaseValid) {
+            check_collision_in_broadphase(nextObj, sPlayerListPriority);
+            nextObj = (struct Object *) nextObj->header.next;
+            continue;
+        }
+#endif
         check_collision_in_list(nextObj, (struct Object *) nextObj->header.next, playerObj);
         check_collision_in_list(nextObj,
                       (struct Object *)  gObjectLists[OBJ_LIST_POLELIKE].next,
@@ -139,6 +398,13 @@ void check_pushable_object_collision(void) {
     struct Object *nextObj = (struct Object *) pushableObj->header.next;
 
     while (nextObj != pushableObj) {
+#ifdef OBJECT_COLLISION_BROADPHASE
+        if (sBroadphaseValid) {
+            check_collision_in_broadphase(nextObj, sPushableListPriority);
+            nextObj = (struct Object *) nextObj->header.next;
+            continue;
+        }
+#endif
         check_collision_in_list(nextObj, (struct Object *) nextObj->header.next, pushableObj);
         nextObj = (struct Object *) nextObj->header.next;
     }
@@ -150,6 +416,13 @@ void check_destructive_object_collision(void) {
 
     while (nextObj != destructiveObj) {
         if (nextObj->oDistanceToMario < 2000.0f && !(nextObj->activeFlags & ACTIVE_FLAG_DESTRUCTIVE_OBJ_DONT_DESTROY)) {
+#ifdef OBJECT_COLLISION_BROADPHASE
+            if (sBroadphaseValid) {
+                check_collision_in_broadphase(nextObj, sDestructiveListPriority);
+                nextObj = (struct Object *) nextObj->header.next;
+                continue;
+            }
+#endif
             check_collision_in_list(nextObj, (struct Object *) nextObj->header.next, destructiveObj);
             check_collision_in_list(nextObj, (struct Object *) gObjectLists[OBJ_LIST_GENACTOR].next,
                           (struct Object *) &gObjectLists[OBJ_LIST_GENACTOR]);
@@ -163,13 +436,16 @@ void check_destructive_object_collision(void) {
 }
 
 void detect_object_collisions(void) {
-    clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_POLELIKE]);
-    clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_PLAYER]);
-    clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_PUSHABLE]);
-    clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_GENACTOR]);
-    clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_LEVEL]);
-    clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_SURFACE]);
-    clear_object_collision((struct Object *) &gObjectLists[OBJ_LIST_DESTRUCTIVE]);
+#ifdef OBJECT_COLLISION_BROADPHASE
+    clear_broadphase();
+#endif
+    clear_object_collision(OBJ_LIST_POLELIKE);
+    clear_object_collision(OBJ_LIST_PLAYER);
+    clear_object_collision(OBJ_LIST_PUSHABLE);
+    clear_object_collision(OBJ_LIST_GENACTOR);
+    clear_object_collision(OBJ_LIST_LEVEL);
+    clear_object_collision(OBJ_LIST_SURFACE);
+    clear_object_collision(OBJ_LIST_DESTRUCTIVE);
     check_player_object_collision();
     check_destructive_object_collision();
     check_pushable_object_collision();
@@ -27,6 +27,7 @@
 #include "spawn_object.h"
 #include "spawn_sound.h"
 #include "puppylights.h"
+#include "puppyprint.h"
 
 static s32 clear_move_flag(u32 *bitSet, s32 flag);
 
@@ -142,6 +143,22 @@ Gfx *geo_switch_area(s32 callContext, struct GraphNode *node, UNUSED void *conte
     return NULL;
 }
 
+/**
+ * Selects the first child of a GEO_SWITCH_ROOM node if its room can be seen from Mario's room or the camera's, or the second one if not.
+ */
+Gfx *geo_switch_room_visible(s32 callContext, struct GraphNode *node, UNUSED void *context) {
+    struct GraphNodeSwitchCase *switchCase = (struct GraphNodeSwitchCase *) node;
+
+    if (callContext == GEO_CONTEXT_RENDER) {
+        update_mario_current_room();
+        switchCase->selectedCase = !is_room_visible(switchCase->parameter);
+    } else {
+        switchCase->selectedCase = 0;
+    }
+
+    return NULL;
+}
+
 void obj_update_pos_from_parent_transformation(Mat4 a0, struct Object *a1) {
     f32 spC = a1->oParentRelativePosX;
     f32 sp8 = a1->oParentRelativePosY;
@@ -203,17 +220,75 @@ void obj_set_held_state(struct Object *obj, const BehaviorScript *heldBehavior)
     }
 }
 
+#ifdef MARIO_RELATIVE_CACHE
+/**
+ * Returns the cache of values relative to Mario for whichever of the two objects isn't Mario, or NULL if neither is.
+ * The cache is emptied first if either object has moved since it was filled, so it's exact even mid-frame.
+ */
+static struct MarioRelativeCache *get_mario_relative_cache(struct Object *obj1, struct Object *obj2) {
+    struct Object *obj;
+
+    if (obj2 == gMarioObject) {
+        obj = obj1;
+    } else if (obj1 == gMarioObject) {
+        obj = obj2;
+    } else {
+        return NULL;
+    }
+
+    struct MarioRelativeCache *cache = &obj->marioRelativeCache;
+
+    if (cache->objPos[0]   != obj->oPosX          || cache->objPos[1]   != obj->oPosY          || cache->objPos[2]   != obj->oPosZ
+     || cache->marioPos[0] != gMarioObject->oPosX || cache->marioPos[1] != gMarioObject->oPosY || cache->marioPos[2] != gMarioObject->oPosZ) {
+        vec3f_copy(cache->objPos, &obj->oPosVec);
+        vec3f_copy(cache->marioPos, &gMarioObject->oPosVec);
+        cache->validFlags = 0;
+    }
+
+    return cache;
+}
+#endif
+
 f32 lateral_dist_between_objects(struct Object *obj1, struct Object *obj2) {
+#ifdef MARIO_RELATIVE_CACHE
+    struct MarioRelativeCache *cache = get_mario_relative_cache(obj1, obj2);
+    if (cache != NULL && (cache->validFlags & MARIO_CACHE_LATERAL_DIST)) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.mario_cache_sqrt_saved);
+        return cache->lateralDist;
+    }
+#endif
     register f32 dx = obj1->oPosX - obj2->oPosX;
     register f32 dz = obj1->oPosZ - obj2->oPosZ;
+    f32 dist = sqrtf(sqr(dx) + sqr(dz));
 
-    return sqrtf(sqr(dx) + sqr(dz));
+#ifdef MARIO_RELATIVE_CACHE
+    if (cache != NULL) {
+        cache->lateralDist = dist;
+        cache->validFlags |= MARIO_CACHE_LATERAL_DIST;
+    }
+#endif
+    return dist;
 }
 
 f32 dist_between_objects(struct Object *obj1, struct Object *obj2) {
+#ifdef MARIO_RELATIVE_CACHE
+    struct MarioRelativeCache *cache = get_mario_relative_cache(obj1, obj2);
+    if (cache != NULL && (cache->validFlags & MARIO_CACHE_DIST)) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.mario_cache_sqrt_saved);
+        return cache->dist;
+    }
+#endif
     Vec3f d;
     vec3_diff(d, &obj2->oPosVec, &obj1->oPosVec);
-    return vec3_mag(d);
+    f32 dist = vec3_mag(d);
+
+#ifdef MARIO_RELATIVE_CACHE
+    if (cache != NULL) {
+        cache->dist = dist;
+        cache->validFlags |= MARIO_CACHE_DIST;
+    }
+#endif
+    return dist;
 }
 
 // Skip sqrtf
@@ -245,7 +320,23 @@ s32 cur_obj_rotate_yaw_toward(s16 target, s16 increment) {
 }
 
 s32 obj_angle_to_object(struct Object *obj1, struct Object *obj2) {
-    return atan2s(obj2->oPosZ - obj1->oPosZ, obj2->oPosX - obj1->oPosX);
+#ifdef MARIO_RELATIVE_CACHE
+    // The angle isn't symmetric, so only the angle from an object to Mario is cached.
+    struct MarioRelativeCache *cache = ((obj2 == gMarioObject) ? get_mario_relative_cache(obj1, obj2) : NULL);
+    if (cache != NULL && (cache->validFlags & MARIO_CACHE_ANGLE)) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.mario_cache_atan_saved);
+        return cache->angle;
+    }
+#endif
+    s16 angle = atan2s(obj2->oPosZ - obj1->oPosZ, obj2->oPosX - obj1->oPosX);
+
+#ifdef MARIO_RELATIVE_CACHE
+    if (cache != NULL) {
+        cache->angle = angle;
+        cache->validFlags |= MARIO_CACHE_ANGLE;
+    }
+#endif
+    return angle;
 }
 
 s32 obj_turn_toward_object(struct Object *obj, struct Object *target, s16 angleIndex, s16 turnAmount) {
@@ -895,6 +986,19 @@ void cur_obj_disable(void) {
     cur_obj_become_intangible();
 }
 
+/**
+ * Stop running the current object's behavior until Mario comes within OBJECT_SLEEP_WAKE_DIST of it,
+ * something collides or interacts with it, or obj_wake is called on it.
+ * Its visibility isn't updated while it sleeps.
+ */
+void cur_obj_sleep(void) {
+    o->activeFlags |= ACTIVE_FLAG_SLEEPING;
+}
+
+void obj_wake(struct Object *obj) {
+    obj->activeFlags &= ~ACTIVE_FLAG_SLEEPING;
+}
+
 void cur_obj_become_intangible(void) {
     // When the timer is negative, the object is intangible and the timer
     // doesn't count down
@@ -909,14 +1013,27 @@ void obj_become_tangible(struct Object *obj) {
     obj->oIntangibleTimer = 0;
 }
 
+/**
+ * Find the floor under a point for the current object, going through the
+ * object's floor cache if it has OBJ_FLAG_FLOOR_CACHE set.
+ */
+f32 cur_obj_find_floor(f32 x, f32 y, f32 z, struct Surface **pfloor) {
+#ifdef OBJECT_FLOOR_CACHE
+    if (o->oFlags & OBJ_FLAG_FLOOR_CACHE) {
+        return find_floor_cached(x, y, z, pfloor, &o->floorCache);
+    }
+#endif
+    return find_floor(x, y, z, pfloor);
+}
+
 void cur_obj_update_floor_height(void) {
     struct Surface *floor;
-    o->oFloorHeight = find_floor(o->oPosX, o->oPosY, o->oPosZ, &floor);
+    o->oFloorHeight = cur_obj_find_floor(o->oPosX, o->oPosY, o->oPosZ, &floor);
 }
 
 struct Surface *cur_obj_update_floor_height_and_get_floor(void) {
     struct Surface *floor;
-    o->oFloorHeight = find_floor(o->oPosX, o->oPosY, o->oPosZ, &floor);
+    o->oFloorHeight = cur_obj_find_floor(o->oPosX, o->oPosY, o->oPosZ, &floor);
     return floor;
 }
 
@@ -952,7 +1069,7 @@ static void cur_obj_move_xz(f32 steepSlopeNormalY, s32 careAboutEdgesAndSteepSlo
     f32 intendedX = o->oPosX + o->oVelX;
     f32 intendedZ = o->oPosZ + o->oVelZ;
 
-    f32 intendedFloorHeight = find_floor(intendedX, o->oPosY, intendedZ, &intendedFloor);
+    f32 intendedFloorHeight = cur_obj_find_floor(intendedX, o->oPosY, intendedZ, &intendedFloor);
     f32 deltaFloorHeight = intendedFloorHeight - o->oFloorHeight;
 
     o->oMoveFlags &= ~OBJ_MOVE_HIT_EDGE;
@@ -1323,7 +1440,7 @@ static s32 cur_obj_detect_steep_floor(s16 steepAngleDegrees) {
     if (o->oForwardVel != 0.0f) {
         f32 intendedX = o->oPosX + o->oVelX;
         f32 intendedZ = o->oPosZ + o->oVelZ;
-        f32 intendedFloorHeight = find_floor(intendedX, o->oPosY, intendedZ, &intendedFloor);
+        f32 intendedFloorHeight = cur_obj_find_floor(intendedX, o->oPosY, intendedZ, &intendedFloor);
         f32 deltaFloorHeight = intendedFloorHeight - o->oFloorHeight;
 
         if (intendedFloorHeight < FLOOR_LOWER_LIMIT_MISC) {
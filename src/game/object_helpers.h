@@ -63,6 +63,7 @@ Gfx *geo_update_projectile_pos_from_parent(s32 callContext, UNUSED struct GraphN
 Gfx *geo_update_layer_transparency(s32 callContext, struct GraphNode *node, UNUSED void *context);
 Gfx *geo_switch_anim_state(s32 callContext, struct GraphNode *node, UNUSED void *context);
 Gfx *geo_switch_area(s32 callContext, struct GraphNode *node, UNUSED void *context);
+Gfx *geo_switch_room_visible(s32 callContext, struct GraphNode *node, UNUSED void *context);
 void obj_update_pos_from_parent_transformation(Mat4 mtx, struct Object *obj);
 void create_transformation_from_matrices(Mat4 a0, Mat4 a1, Mat4 a2);
 void obj_set_held_state(struct Object *obj, const BehaviorScript *heldBehavior);
@@ -146,9 +147,12 @@ void obj_mark_for_deletion(struct Object *obj);
 // Hackersm64 backwards compatibility
 #define mark_obj_for_deletion obj_mark_for_deletion
 void cur_obj_disable(void);
+void cur_obj_sleep(void);
+void obj_wake(struct Object *obj);
 void cur_obj_become_intangible(void);
 void cur_obj_become_tangible(void);
 void obj_become_tangible(struct Object *obj);
+f32 cur_obj_find_floor(f32 x, f32 y, f32 z, struct Surface **pfloor);
 void cur_obj_update_floor_height(void);
 struct Surface *cur_obj_update_floor_height_and_get_floor(void);
 void cur_obj_apply_drag_xz(f32 dragStrength);
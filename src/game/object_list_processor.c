@@ -5,6 +5,7 @@
 #include "behavior_data.h"
 #include "camera.h"
 #include "debug.h"
+#include "game_init.h"
 #include "engine/behavior_script.h"
 #include "engine/graph_node.h"
 #include "engine/surface_collision.h"
@@ -86,6 +87,11 @@ struct ObjectNode *gObjectLists;
  */
 struct ObjectNode gFreeObjectList;
 
+/**
+ * One bit per slot in gObjectPool, set while the slot holds an object.
+ */
+u32 gObjectSlotsUsed[OBJECT_SLOT_BITMAP_WORDS];
+
 /**
  * The object representing Mario.
  */
@@ -283,6 +289,60 @@ void bhv_mario_update(void) {
     }
 }
 
+#ifdef OBJECT_TICK_LOD
+/**
+ * Whether an object's behavior should be skipped this frame, either because it's asleep, because it's waiting
+ * for Mario to come in range before its first run, or because it has OBJ_FLAG_TICK_LOD and is far enough from Mario
+ * to only run every few frames. Sleeping and deferred objects are woken here.
+ */
+static s32 should_skip_object_update(struct Object *obj) {
+    if (!(obj->activeFlags & (ACTIVE_FLAG_SLEEPING | ACTIVE_FLAG_DEFERRED_INIT)) && !(obj->oFlags & OBJ_FLAG_TICK_LOD)) {
+        return FALSE;
+    }
+
+    // Anything that's being interacted with needs to respond to it straight away.
+    if (gMarioObject == NULL || obj->oInteractStatus != 0 || obj->numCollidedObjs != 0) {
+        obj->activeFlags &= ~(ACTIVE_FLAG_SLEEPING | ACTIVE_FLAG_DEFERRED_INIT);
+        return FALSE;
+    }
+
+    Vec3f d;
+    vec3_diff(d, &obj->oPosVec, &gMarioObject->oPosVec);
+    f32 distSq = vec3_sumsq(d);
+
+    if (obj->activeFlags & ACTIVE_FLAG_DEFERRED_INIT) {
+        // Deferred objects are hidden until then, so they have to run before they'd come into view.
+        if (distSq < sqr(obj->oDrawingDistance)) {
+            obj->activeFlags &= ~ACTIVE_FLAG_DEFERRED_INIT;
+            return FALSE;
+        }
+        return TRUE;
+    }
+
+    if (obj->activeFlags & ACTIVE_FLAG_SLEEPING) {
+        if (distSq < sqr(OBJECT_SLEEP_WAKE_DIST)) {
+            obj->activeFlags &= ~ACTIVE_FLAG_SLEEPING;
+            return FALSE;
+        }
+        return TRUE;
+    }
+
+    u32 intervalMask;
+    if (distSq > sqr(OBJECT_TICK_LOD_DIST_8)) {
+        intervalMask = (8 - 1);
+    } else if (distSq > sqr(OBJECT_TICK_LOD_DIST_4)) {
+        intervalMask = (4 - 1);
+    } else if (distSq > sqr(OBJECT_TICK_LOD_DIST_2)) {
+        intervalMask = (2 - 1);
+    } else {
+        return FALSE;
+    }
+
+    // Offset by pool slot so that objects sharing an interval don't all run on the same frame.
+    return (((gGlobalTimer + (obj - gObjectPool)) & intervalMask) != 0);
+}
+#endif
+
 /**
  * Update every object that occurs after firstObj in the given object list,
  * including firstObj itself. Return the number of objects that were updated.
@@ -294,7 +354,18 @@ s32 update_objects_starting_at(struct ObjectNode *objList, struct ObjectNode *fi
         gCurrentObject = (struct Object *) firstObj;
 
         gCurrentObject->header.gfx.node.flags |= GRAPH_RENDER_HAS_ANIMATION;
+#ifdef OBJECT_TICK_LOD
+        if (should_skip_object_update(gCurrentObject)) {
+            if (gCurrentObject->tickDelta < 0xFF) {
+                gCurrentObject->tickDelta++;
+            }
+        } else {
+            cur_obj_update();
+            gCurrentObject->tickDelta = 1;
+        }
+#else
         cur_obj_update();
+#endif
 
         firstObj = firstObj->next;
         count++;
@@ -555,7 +626,7 @@ void update_terrain_objects(void) {
     profiler_update(PROFILER_TIME_DYNAMIC, profiler_get_delta(PROFILER_DELTA_COLLISION) - first);
 
     // If the dynamic surface pool has overflowed, throw an error.
-    assert((uintptr_t)gDynamicSurfacePoolEnd <= (uintptr_t)gDynamicSurfacePool + DYNAMIC_SURFACE_POOL_SIZE, "Dynamic surface pool size exceeded");
+    assert((uintptr_t)gDynamicSurfacePoolEnd <= (uintptr_t)DYNAMIC_SURFACE_POOL_LIMIT, "Dynamic surface pool size exceeded");
 }
 
 /**
@@ -620,14 +691,17 @@ UNUSED static u16 unused_get_elapsed_time(u64 *cycleCounts, s32 index) {
  * Clear all floors tied to dynamic collision, as they become invalid once the dynamic
  * surfaces are cleared.
  * 
- * NOTE: Checking over the full object pool is slower than checking against the linked lists of active
- * objects until the active object pool is around half capacity, after which, this is faster.
- * Change this function to use a linked list instead if you add any additional logic here whatsoever.
+ * NOTE: This walks gObjectSlotsUsed rather than the object lists, so that free slots are skipped 32 at a time
+ * without touching the objects themselves. Unloaded objects already have their floor cleared.
  */
 void clear_dynamic_surface_references(void) {
-    for (s32 i = 0; i < OBJECT_POOL_CAPACITY; i++) {
-        if (gObjectPool[i].oFloor && gObjectPool[i].oFloor->flags & SURFACE_FLAG_DYNAMIC) {
-            gObjectPool[i].oFloor = NULL;
+    for (s32 word = 0; word < OBJECT_SLOT_BITMAP_WORDS; word++) {
+        u32 bits = gObjectSlotsUsed[word];
+
+        for (s32 i = (word * 32); bits != 0; i++, bits >>= 1) {
+            if ((bits & 1) && gObjectPool[i].oFloor && gObjectPool[i].oFloor->flags & SURFACE_FLAG_DYNAMIC) {
+                gObjectPool[i].oFloor = NULL;
+            }
         }
     }
 }
@@ -26,6 +26,11 @@ enum gTimeStopStateFlags {
  */
 #define OBJECT_POOL_CAPACITY 240
 
+/**
+ * The number of words in gObjectSlotsUsed, one bit per pool slot.
+ */
+#define OBJECT_SLOT_BITMAP_WORDS ((OBJECT_POOL_CAPACITY + 31) / 32)
+
 /**
  * Every object is categorized into an object list, which controls the order
  * they are processed and which objects they can collide with.
@@ -82,6 +87,7 @@ extern struct Object gObjectPool[];
 extern struct Object gMacroObjectDefaultParent;
 extern struct ObjectNode *gObjectLists;
 extern struct ObjectNode gFreeObjectList;
+extern u32 gObjectSlotsUsed[OBJECT_SLOT_BITMAP_WORDS];
 
 extern struct Object *gMarioObject;
 extern struct Object *gLuigiObject;
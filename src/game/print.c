@@ -420,6 +420,7 @@ void render_text_labels(void) {
     s32 i;
     s32 j;
     s8 glyphIndex;
+    s8 loadedGlyph = GLYPH_SPACE; // Spaces are never loaded, so this means nothing is loaded yet.
     Mtx *mtx;
 
     if (sTextLabelsCount == 0) {
@@ -452,12 +453,20 @@ void render_text_labels(void) {
 
                     add_glyph_texture(GLYPH_UMLAUT);
                     render_textrect(sTextLabels[i]->x, sTextLabels[i]->y + 3, j);
+                    loadedGlyph = GLYPH_UMLAUT;
                 } else {
-                    add_glyph_texture(glyphIndex);
+                    if (glyphIndex != loadedGlyph) {
+                        add_glyph_texture(glyphIndex);
+                        loadedGlyph = glyphIndex;
+                    }
                     render_textrect(sTextLabels[i]->x, sTextLabels[i]->y, j);
                 }
 #else
-                add_glyph_texture(glyphIndex);
+                // Repeated glyphs (like the zeroes of a coin count) are still in TMEM, so only load a glyph when it changes.
+                if (glyphIndex != loadedGlyph) {
+                    add_glyph_texture(glyphIndex);
+                    loadedGlyph = glyphIndex;
+                }
                 render_textrect(sTextLabels[i]->x, sTextLabels[i]->y, j);
 #endif
             }
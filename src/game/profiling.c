@@ -95,6 +95,11 @@ void profiler_audio_started() {
 #endif
 }
 
+// Time the game thread spent blocked waiting for the RCP to finish a Gfx task.
+void profiler_rcp_wait_update(u32 time) {
+    buffer_update(&all_profiling_data[PROFILER_TIME_RCP_WAIT], osGetCount() - time, profile_buffer_index);
+}
+
 #ifdef PUPPYPRINT_DEBUG
 
 void profiler_collision_reset() {
@@ -231,7 +236,7 @@ u32 profiler_get_rdp_microseconds() {
 
 void profiler_print_times() {
     u32 microseconds[PROFILER_TIME_COUNT];
-    char text_buffer[196];
+    char text_buffer[288];
 
     update_fps_timer();
     update_total_timer();
@@ -279,6 +284,7 @@ void profiler_print_times() {
 #ifdef PUPPYPRINT_DEBUG
             " Camera\t\t%d\n"
 #endif
+            " RCP wait\t\t%d\n"
             "\n"
             "RDP\t\t%d (%d%%)\n"
             " Tmem\t\t\t%d\n"
@@ -303,6 +309,7 @@ void profiler_print_times() {
 #ifdef PUPPYPRINT_DEBUG
             microseconds[PROFILER_TIME_CAMERA],
 #endif
+            microseconds[PROFILER_TIME_RCP_WAIT],
             max_rdp, max_rdp / 333,
             microseconds[PROFILER_TIME_TMEM],
             microseconds[PROFILER_TIME_CMD],
@@ -41,6 +41,7 @@ enum ProfilerTime {
     PROFILER_TIME_GFX,
     PROFILER_TIME_COLLISION,
     PROFILER_TIME_CAMERA,
+    PROFILER_TIME_RCP_WAIT,
 #ifdef PUPPYPRINT_DEBUG
     PROFILER_TIME_PUPPYPRINT1,
     PROFILER_TIME_PUPPYPRINT2,
@@ -88,6 +89,7 @@ typedef struct {
     u32 total;
 } ProfileTimeData;
 extern ProfileTimeData all_profiling_data[PROFILER_TIME_COUNT];
+extern int profile_buffer_index;
 
 void profiler_update(enum ProfilerTime which, u32 delta);
 void profiler_print_times();
@@ -97,6 +99,7 @@ void profiler_rsp_completed(enum ProfilerRSPTime which);
 void profiler_rsp_resumed();
 void profiler_audio_started();
 void profiler_audio_completed();
+void profiler_rcp_wait_update(u32 time);
 #ifdef PUPPYPRINT_DEBUG
 void profiler_collision_reset();
 void profiler_collision_completed();
@@ -127,6 +130,7 @@ static ALWAYS_INLINE void profiler_rsp_yielded() {
 #define profiler_rsp_resumed()
 #define profiler_audio_started()
 #define profiler_audio_completed()
+#define profiler_rcp_wait_update(time)
 #define profiler_rsp_yielded()
 #define profiler_collision_reset()
 #define profiler_collision_completed()
@@ -144,7 +144,7 @@ void puppyprint_calculate_ram_usage(void) {
     ramsizeSegment[RAM_ZBUFFER] = (u32)&_zbufferSegmentBssEnd - (u32)&_zbufferSegmentBssStart;
     ramsizeSegment[RAM_GODDARD] = (u32)&_goddardSegmentEnd - (u32)&_goddardSegmentStart;
     ramsizeSegment[RAM_POOLS] = gPoolMem;
-    ramsizeSegment[RAM_COLLISION] = ((u32) gCurrStaticSurfacePoolEnd - (u32) gCurrStaticSurfacePool) + ((u32) gDynamicSurfacePoolEnd - (u32) gDynamicSurfacePool);
+    ramsizeSegment[RAM_COLLISION] = ((u32) gCurrStaticSurfacePoolEnd - (u32) gCurrStaticSurfacePool) + (DYNAMIC_SURFACE_POOL_SIZE - ((u32) DYNAMIC_SURFACE_POOL_LIMIT - (u32) gDynamicSurfacePoolEnd));
     ramsizeSegment[RAM_MISC] = gMiscMem;
     ramsizeSegment[RAM_AUDIO] = gAudioHeapSize;
 }
@@ -232,6 +232,160 @@ void set_segment_memory_printout(u32 segment, u32 amount) {
     ramsizeSegment[segment + nameTable - 2] = amount;
 }
 
+struct GfxPoolUsage {
+    u32 gfx;   // Gfx commands added to the master display list.
+    u32 alloc; // Bytes taken from the end of the pool by alloc_display_list.
+};
+
+static const char *gfxPoolUserNames[GFX_POOL_USER_COUNT] = {
+    "Other",
+    "Graph",
+    "Shadows",
+    "Envfx",
+    "HUD",
+    "Axotext",
+    "Puppyprint",
+};
+
+STATIC_ASSERT(ARRAY_COUNT(gfxPoolUserNames) == GFX_POOL_USER_COUNT, "gfxPoolUserNames has incorrect number of entries!");
+
+static struct GfxPoolUsage sGfxPoolUsage[GFX_POOL_USER_COUNT]; // The frame being built.
+static struct GfxPoolUsage sGfxPoolLastFrame[GFX_POOL_USER_COUNT];
+static struct GfxPoolUsage sGfxPoolPeak[GFX_POOL_USER_COUNT];
+static u32 sGfxPoolLastFrameTotal; // In bytes, like the rest of the totals.
+static u32 sGfxPoolPeakTotal;
+static u32 sGfxPoolSecondPeak;
+static u32 sGfxPoolHistory[GFX_POOL_HISTORY_SIZE]; // The highest total of each of the last few seconds.
+static u8  sGfxPoolHistoryPos;
+static u16 sGfxPoolDroppedLists;
+static u32 sGfxPoolOverflowFrames;
+static s32 sGfxPoolUser;
+static Gfx *sGfxPoolLastHead;
+static u8  *sGfxPoolLastEnd;
+
+/**
+ * Charges everything added to the Gfx pool since the last user change to the current user.
+ */
+static void gfx_pool_charge_user(void) {
+    sGfxPoolUsage[sGfxPoolUser].gfx   += (gDisplayListHead - sGfxPoolLastHead);
+    sGfxPoolUsage[sGfxPoolUser].alloc += (sGfxPoolLastEnd - gGfxPoolEnd);
+    sGfxPoolLastHead = gDisplayListHead;
+    sGfxPoolLastEnd  = gGfxPoolEnd;
+}
+
+/**
+ * Sets which part of the game the Gfx pool usage from now on counts towards, and returns the previous one.
+ */
+s32 gfx_pool_set_user(s32 user) {
+    s32 prevUser = sGfxPoolUser;
+
+    gfx_pool_charge_user();
+    sGfxPoolUser = user;
+    return prevUser;
+}
+
+/**
+ * Starts counting the usage of a freshly selected Gfx pool.
+ */
+void gfx_pool_frame_start(void) {
+    bzero(sGfxPoolUsage, sizeof(sGfxPoolUsage));
+    sGfxPoolUser     = GFX_POOL_USER_OTHER;
+    sGfxPoolLastHead = gDisplayListHead;
+    sGfxPoolLastEnd  = gGfxPoolEnd;
+}
+
+/**
+ * Records the usage of the finished frame, and updates the high-water marks.
+ */
+void gfx_pool_frame_end(void) {
+    u32 total = (((u8 *) gDisplayListHead - (u8 *) gGfxPool->buffer) + ((u8 *) &gGfxPool->buffer[GFX_POOL_SIZE] - gGfxPoolEnd));
+    s32 i;
+
+    gfx_pool_charge_user();
+    for (i = 0; i < GFX_POOL_USER_COUNT; i++) {
+        sGfxPoolLastFrame[i] = sGfxPoolUsage[i];
+        sGfxPoolPeak[i].gfx   = MAX(sGfxPoolPeak[i].gfx,   sGfxPoolUsage[i].gfx);
+        sGfxPoolPeak[i].alloc = MAX(sGfxPoolPeak[i].alloc, sGfxPoolUsage[i].alloc);
+    }
+    sGfxPoolLastFrameTotal = total;
+    sGfxPoolPeakTotal  = MAX(sGfxPoolPeakTotal, total);
+    sGfxPoolSecondPeak = MAX(sGfxPoolSecondPeak, total);
+
+    if ((gGlobalTimer % 30) == 0) {
+        sGfxPoolHistory[sGfxPoolHistoryPos] = sGfxPoolSecondPeak;
+        sGfxPoolHistoryPos = ((sGfxPoolHistoryPos + 1) % GFX_POOL_HISTORY_SIZE);
+        sGfxPoolSecondPeak = 0;
+    }
+
+    if (gPuppyCallCounter.gfx_dropped_lists != 0) {
+        // Only log the first frame of an overflow, rather than every frame it lasts.
+        if (sGfxPoolDroppedLists == 0) {
+            append_puppyprint_log("Gfx pool full, dropped %d display lists.", gPuppyCallCounter.gfx_dropped_lists);
+        }
+        sGfxPoolOverflowFrames++;
+    }
+    sGfxPoolDroppedLists = gPuppyCallCounter.gfx_dropped_lists;
+}
+
+static void print_gfx_pool_row(s32 y, const char *name, const char *centre, const char *right) {
+    if (y > 0 && y < SCREEN_HEIGHT) {
+        print_small_text_light(24, y, name, PRINT_TEXT_ALIGN_LEFT, PRINT_ALL, FONT_DEFAULT);
+        print_small_text_light(SCREEN_WIDTH/2, y, centre, PRINT_TEXT_ALIGN_CENTRE, PRINT_ALL, FONT_DEFAULT);
+        print_small_text_light(SCREEN_WIDTH - 24, y, right, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_DEFAULT);
+    }
+}
+
+/**
+ * Prints how much of the Gfx pool each part of the game used last frame and at most, in Gfx commands and allocated
+ * bytes, followed by a graph of the highest total of each of the last few seconds. The line across the graph is
+ * where GFX_POOL_RESERVE starts, past which the level's display lists get dropped.
+ */
+static void print_gfx_pool_overview(s32 y) {
+    char centre[32];
+    char right[32];
+    s32 i;
+
+    sprintf(centre, "%d / %d", (sGfxPoolLastFrameTotal / sizeof(Gfx)), GFX_POOL_SIZE);
+    sprintf(right, "Peak: %d", (sGfxPoolPeakTotal / sizeof(Gfx)));
+    print_gfx_pool_row(y, "Gfx Pool:", centre, right);
+    y += 12;
+    print_gfx_pool_row(y, "", "Gfx (peak)", "Alloc (peak)");
+    y += 12;
+    for (i = 0; i < GFX_POOL_USER_COUNT; i++) {
+        sprintf(centre, "%d (%d)", sGfxPoolLastFrame[i].gfx, sGfxPoolPeak[i].gfx);
+        sprintf(right, "0x%X (0x%X)", sGfxPoolLastFrame[i].alloc, sGfxPoolPeak[i].alloc);
+        print_gfx_pool_row(y, gfxPoolUserNames[i], centre, right);
+        y += 12;
+    }
+    sprintf(centre, "%d lists", sGfxPoolDroppedLists);
+    sprintf(right, "%d frames", sGfxPoolOverflowFrames);
+    print_gfx_pool_row(y, "Dropped:", centre, right);
+    y += 16;
+
+    if (y + 32 > 0 && y < SCREEN_HEIGHT) {
+        s32 x = ((SCREEN_WIDTH / 2) - (GFX_POOL_HISTORY_SIZE * 4));
+        s32 limitY = (y + 32 - ((32 * (GFX_POOL_SIZE - GFX_POOL_RESERVE)) / GFX_POOL_SIZE));
+
+        prepare_blank_box();
+        render_blank_box(x, y, (x + (GFX_POOL_HISTORY_SIZE * 8)), (y + 32), 0x40, 0x40, 0x40, 0xC0);
+        for (i = 0; i < GFX_POOL_HISTORY_SIZE; i++) {
+            // Oldest on the left.
+            u32 peak = (sGfxPoolHistory[(sGfxPoolHistoryPos + i) % GFX_POOL_HISTORY_SIZE] / sizeof(Gfx));
+            s32 height = ((32 * MIN(peak, GFX_POOL_SIZE)) / GFX_POOL_SIZE);
+
+            if (height > 0) {
+                if (peak > (GFX_POOL_SIZE - GFX_POOL_RESERVE)) {
+                    render_blank_box((x + (i * 8) + 1), (y + 32 - height), (x + (i * 8) + 7), (y + 32), 0xFF, 0x40, 0x40, 0xFF);
+                } else {
+                    render_blank_box((x + (i * 8) + 1), (y + 32 - height), (x + (i * 8) + 7), (y + 32), 0x40, 0xFF, 0x40, 0xFF);
+                }
+            }
+        }
+        render_blank_box(x, limitY, (x + (GFX_POOL_HISTORY_SIZE * 8)), (limitY + 1), 0xFF, 0xFF, 0xFF, 0xFF);
+        finish_blank_box();
+    }
+}
+
 void print_ram_overview(void) {
     char textBytes[64];
     s32 y = 56;
@@ -283,6 +437,8 @@ void print_ram_overview(void) {
         }
         y += 12;
     }
+
+    print_gfx_pool_overview(y + 12 - gPPSegScroll);
 }
 
 static const char *audioPoolNames[NUM_AUDIO_POOLS] = {
@@ -470,7 +626,7 @@ void puppyprint_render_collision(void) {
     sprintf(textBytes, "Static Pool Size: 0x%X\nDynamic Pool Size: 0x%X\nDynamic Pool Used: 0x%X\nSurfaces Allocated: %d\nNodes Allocated: %d", 
     gTotalStaticSurfaceData,
     DYNAMIC_SURFACE_POOL_SIZE,
-    (uintptr_t)gDynamicSurfacePoolEnd - (uintptr_t)gDynamicSurfacePool,
+    DYNAMIC_SURFACE_POOL_SIZE - ((uintptr_t)DYNAMIC_SURFACE_POOL_LIMIT - (uintptr_t)gDynamicSurfacePoolEnd),
     gSurfacesAllocated, gSurfaceNodesAllocated);
     print_small_text_light(SCREEN_WIDTH-16, 60, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, 1);
 
@@ -504,9 +660,10 @@ void print_basic_profiling(void) {
 }
 
 void puppyprint_render_standard(void) {
-    char textBytes[128];
+    char textBytes[288];
+    char *strp = textBytes;
 
-    sprintf(textBytes, "Matrix Muls: %d\n\nCollision Checks\nFloors: %d\nWalls: %d\nCeilings: %d\n Water: %d\nRaycasts: %d",
+    strp += sprintf(strp, "Matrix Muls: %d\n\nCollision Checks\nFloors: %d\nWalls: %d\nCeilings: %d\n Water: %d\nRaycasts: %d",
             gPuppyCallCounter.matrix,
             gPuppyCallCounter.collision_floor,
             gPuppyCallCounter.collision_wall,
@@ -514,6 +671,26 @@ void puppyprint_render_standard(void) {
             gPuppyCallCounter.collision_water,
             gPuppyCallCounter.collision_raycast
     );
+#ifdef OBJECT_FLOOR_CACHE
+    // Every cache hit is a find_floor call that never had to walk the static floors.
+    u32 cacheQueries = (gPuppyCallCounter.collision_floor_cache_hit + gPuppyCallCounter.collision_floor_cache_miss);
+    strp += sprintf(strp, "\nFloor Cache: %d%%\nCalls Saved: %d",
+            (cacheQueries != 0) ? ((gPuppyCallCounter.collision_floor_cache_hit * 100) / cacheQueries) : 0,
+            gPuppyCallCounter.collision_floor_cache_hit
+    );
+#endif
+#ifdef MARIO_RELATIVE_CACHE
+    strp += sprintf(strp, "\nMario Cache\nSqrts Saved: %d\nAtans Saved: %d",
+            gPuppyCallCounter.mario_cache_sqrt_saved,
+            gPuppyCallCounter.mario_cache_atan_saved
+    );
+#endif
+#ifdef ANIMATION_POSE_CACHE
+    sprintf(strp, "\nAnim Poses\nDecoded: %d\nReused: %d",
+            gPuppyCallCounter.anim_pose_decoded,
+            gPuppyCallCounter.anim_pose_reused
+    );
+#endif
     print_small_text_light(SCREEN_WIDTH-16, 32, textBytes, PRINT_TEXT_ALIGN_RIGHT, PRINT_ALL, FONT_OUTLINE);
 }
 
@@ -13,14 +13,28 @@
 #define PUPPYPRINT_ADD_COUNTER(x) x++
 #define PUPPYPRINT_GET_SNAPSHOT() u32 first = osGetCount()
 #define PUPPYPRINT_GET_SNAPSHOT_TYPE(type) u32 first = profiler_get_delta(type)
+// Charges what's added to the Gfx pool to a GfxPoolUser until GFX_POOL_POP_USER, in the same scope.
+#define GFX_POOL_PUSH_USER(user) s32 prevGfxPoolUser = gfx_pool_set_user(user)
+#define GFX_POOL_POP_USER() gfx_pool_set_user(prevGfxPoolUser)
 void append_puppyprint_log(const char *str, ...);
+s32 gfx_pool_set_user(s32 user);
+void gfx_pool_frame_start(void);
+void gfx_pool_frame_end(void);
 #else
 #define PUPPYPRINT_ADD_COUNTER(x)
 #define PUPPYPRINT_GET_SNAPSHOT()
 #define PUPPYPRINT_GET_SNAPSHOT_TYPE(type)
+#define GFX_POOL_PUSH_USER(user)
+#define GFX_POOL_POP_USER()
 #define append_puppyprint_log(...)
+#define gfx_pool_set_user(user)
+#define gfx_pool_frame_start()
+#define gfx_pool_frame_end()
 #endif
 
+// How many seconds of Gfx pool high-water marks are kept for the RAM page.
+#define GFX_POOL_HISTORY_SIZE 16
+
 
 #ifdef PUPPYPRINT_DEBUG_CYCLES
     #define PP_CYCLE_CONV(x) (x)
@@ -49,7 +63,14 @@ struct CallCounter {
     u16 collision_ceil;
     u16 collision_water;
     u16 collision_raycast;
+    u16 collision_floor_cache_hit;
+    u16 collision_floor_cache_miss;
+    u16 mario_cache_sqrt_saved;
+    u16 mario_cache_atan_saved;
     u16 matrix;
+    u16 anim_pose_decoded;
+    u16 anim_pose_reused;
+    u16 gfx_dropped_lists;
 };
 
 struct PuppyPrintPage{
@@ -83,6 +104,17 @@ enum rspFlags
     RSP_GFX_RESUME,
 };
 
+enum GfxPoolUser {
+    GFX_POOL_USER_OTHER,
+    GFX_POOL_USER_GRAPH,
+    GFX_POOL_USER_SHADOWS,
+    GFX_POOL_USER_ENVFX,
+    GFX_POOL_USER_HUD,
+    GFX_POOL_USER_AXOTEXT,
+    GFX_POOL_USER_PUPPYPRINT,
+    GFX_POOL_USER_COUNT
+};
+
 enum PPPages {
 #ifdef USE_PROFILER
     PUPPYPRINT_PAGE_PROFILER,
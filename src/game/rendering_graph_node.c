@@ -50,6 +50,9 @@
 s16 gMatStackIndex = 0;
 ALIGNED16 Mat4 gMatStack[32];
 ALIGNED16 Mtx *gMatStackFixed[32];
+// The stamp of each matrix on the stack that came from a GraphNodeMatrixCache, or 0 if it isn't static.
+static u32 sMatStackStamps[32];
+static u32 sMatrixCacheStamp = 1;
 f32 sAspectRatio;
 
 /**
@@ -64,6 +67,14 @@ struct GeoAnimState {
     /*0x04*/ f32 translationMultiplier;
     /*0x08*/ u16 *attribute;
     /*0x0C*/ s16 *data;
+#ifdef ANIMATION_POSE_CACHE
+    /*0x10*/ struct Animation *anim;
+    /*0x14*/ u16 *index;
+#ifdef ANIMATION_FRAME_INTERPOLATION
+    /*0x18*/ s16 nextFrame;
+    /*0x1A*/ u16 blend;
+#endif
+#endif
 };
 
 // For some reason, this is a GeoAnimState struct, but the current state consists
@@ -77,6 +88,37 @@ f32 gCurrAnimTranslationMultiplier;
 u16 *gCurrAnimAttribute;
 s16 *gCurrAnimData;
 
+#ifdef ANIMATION_POSE_CACHE
+// How many decoded poses are kept. Must be a power of two.
+#define ANIM_POSE_CACHE_SIZE 32
+// The most attribute values a cached pose holds, enough for the translation and 31 bones.
+// Any attributes past that are decoded from the animation data every time.
+#define ANIM_POSE_MAX_VALUES 96
+
+/**
+ * An animation decoded at one frame: the value of each of its attributes, in the order of its index table.
+ * Poses are filled in as the bones are drawn, so only the first 'numValues' are valid.
+ */
+struct AnimPose {
+    struct Animation *anim;
+    s16 frame;
+    u16 numValues;
+    s16 values[ANIM_POSE_MAX_VALUES];
+};
+
+static struct AnimPose sAnimPoseCache[ANIM_POSE_CACHE_SIZE];
+
+// The rest of the current animation state, for the pose cache.
+static struct Animation *sCurrAnim;
+static u16 *sCurrAnimIndex;
+static struct AnimPose *sCurrAnimPose; // Looked up by the first attribute that's read.
+#ifdef ANIMATION_FRAME_INTERPOLATION
+static struct AnimPose *sCurrAnimNextPose;
+static s16 sCurrAnimNextFrame;
+static u16 sCurrAnimBlend; // How far the animation is towards the next frame, out of 0x10000.
+#endif
+#endif
+
 struct AllocOnlyPool *gDisplayListHeap;
 
 /* Rendermode settings for cycle 1 for all 8 or 13 layers. */
@@ -161,6 +203,7 @@ ALIGNED16 struct GraphNodeObject *gCurGraphNodeObject = NULL;
 ALIGNED16 struct GraphNodeHeldObject *gCurGraphNodeHeldObject = NULL;
 u16 gAreaUpdateCounter = 0;
 LookAt* gCurLookAt;
+static u32 sMasterListCounter = 0;
 
 #if SILHOUETTE
 // AA_EN        Enable anti aliasing (not actually used for AA in this case).
@@ -344,6 +387,171 @@ Mtx identityMatrixWorldScale = {{
      0x00000000,                            LOWER_FIXED(1.0f)               <<  0}
 }};
 
+#ifdef SORT_MASTER_LIST_LAYERS
+#define MASTER_LIST_SORT_RADIX_BITS 8
+#define MASTER_LIST_SORT_RADIX_SIZE (1 << MASTER_LIST_SORT_RADIX_BITS)
+
+static struct DisplayListNode *sSortBucketHeads[MASTER_LIST_SORT_RADIX_SIZE];
+static struct DisplayListNode *sSortBucketTails[MASTER_LIST_SORT_RADIX_SIZE];
+
+/**
+ * Whether the draw order within a layer doesn't matter, because it's z-buffered and doesn't blend or decal.
+ */
+static s32 is_layer_sortable(s32 layer) {
+    switch (layer) {
+        case LAYER_OPAQUE:
+        case LAYER_OPAQUE_INTER:
+        case LAYER_ALPHA:
+#if SILHOUETTE
+        case LAYER_SILHOUETTE_OPAQUE:
+        case LAYER_SILHOUETTE_ALPHA:
+        case LAYER_OCCLUDE_SILHOUETTE_OPAQUE:
+        case LAYER_OCCLUDE_SILHOUETTE_ALPHA:
+#endif
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/**
+ * Stable LSD radix sort of a layer's display lists by their sort key. The keys are either 0 or KSEG0 pointers
+ * to word aligned graph nodes, so only bits 2 to 25 need to be looked at. The display lists of each object stay
+ * together and in order, which keeps any state set by an object's generated display lists next to its users.
+ */
+static struct DisplayListNode *sort_display_list_nodes(struct DisplayListNode *head) {
+    struct DisplayListNode *currList;
+    struct DisplayListNode *tail;
+    s32 shift, digit;
+
+    // Most layers are already in order, often because they only hold one model.
+    for (currList = head; currList != NULL && currList->next != NULL; currList = currList->next) {
+        if (currList->next->sortKey < currList->sortKey) {
+            break;
+        }
+    }
+    if (currList == NULL || currList->next == NULL) {
+        return head;
+    }
+
+    for (shift = 2; shift < 26; shift += MASTER_LIST_SORT_RADIX_BITS) {
+        bzero(sSortBucketHeads, sizeof(sSortBucketHeads));
+
+        for (currList = head; currList != NULL; currList = currList->next) {
+            digit = ((currList->sortKey >> shift) & (MASTER_LIST_SORT_RADIX_SIZE - 1));
+            if (sSortBucketHeads[digit] == NULL) {
+                sSortBucketHeads[digit] = currList;
+            } else {
+                sSortBucketTails[digit]->next = currList;
+            }
+            sSortBucketTails[digit] = currList;
+        }
+
+        head = NULL;
+        tail = NULL;
+        for (digit = 0; digit < MASTER_LIST_SORT_RADIX_SIZE; digit++) {
+            if (sSortBucketHeads[digit] != NULL) {
+                if (head == NULL) {
+                    head = sSortBucketHeads[digit];
+                } else {
+                    tail->next = sSortBucketHeads[digit];
+                }
+                tail = sSortBucketTails[digit];
+            }
+        }
+        tail->next = NULL;
+    }
+
+    return head;
+}
+
+/**
+ * Sorts each sortable layer of a z-buffered master list.
+ */
+static void sort_master_list_layers(struct GraphNodeMasterList *node) {
+    s32 ucode, layer;
+
+    if (!(node->node.flags & GRAPH_RENDER_Z_BUFFER)) {
+        return;
+    }
+
+    for (ucode = 0; ucode < GRAPH_NODE_NUM_UCODES; ucode++) {
+        for (layer = LAYER_FIRST; layer < LAYER_COUNT; layer++) {
+            if (is_layer_sortable(layer) && node->listHeads[ucode][layer] != NULL) {
+                node->listHeads[ucode][layer] = sort_display_list_nodes(node->listHeads[ucode][layer]);
+            }
+        }
+    }
+}
+#endif
+
+/**
+ * Whether the Gfx pool is too full to fit any more of the level's display lists, leaving GFX_POOL_RESERVE
+ * free for what's drawn after it (plus a few commands for the master list to finish its current layer).
+ */
+static s32 is_gfx_pool_full(void) {
+    return ((gGfxPoolEnd - (u8 *) gDisplayListHead) < (s32) ((GFX_POOL_RESERVE + 8) * sizeof(Gfx)));
+}
+
+/**
+ * Counts the display lists and batched instances that were left out of the master list because the Gfx pool was full.
+ */
+static void drop_display_lists(struct DisplayListNode *list, struct GraphNodeInstancedDisplayList *batch) {
+    for (; list != NULL; list = list->next) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.gfx_dropped_lists);
+    }
+    for (; batch != NULL; batch = batch->nextBatch) {
+        for (list = batch->instanceHead; list != NULL; list = list->next) {
+            PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.gfx_dropped_lists);
+        }
+    }
+}
+
+/**
+ * Adds the instance batches of a layer to the master list. Returns TRUE if the Gfx pool filled up along the way,
+ * in which case the rest of the instances are dropped.
+ */
+static s32 geo_process_instance_batches(struct GraphNodeInstancedDisplayList *batch, UNUSED s32 isSilhouette) {
+    struct DisplayListNode *instance;
+
+    for (; batch != NULL; batch = batch->nextBatch) {
+#if SILHOUETTE
+        if (isSilhouette) {
+            gSPDisplayList(gDisplayListHead++, dl_silhouette_begin);
+        }
+#endif
+#ifdef F3DEX_GBI_2
+        // Same as geo_append_display_list, for materials that use G_TEXTURE_GEN.
+        gSPLookAt(gDisplayListHead++, gCurLookAt);
+#endif
+        if (batch->materialList != NULL) {
+            gSPDisplayList(gDisplayListHead++, batch->materialList);
+        }
+        for (instance = batch->instanceHead; instance != NULL; instance = instance->next) {
+            if (is_gfx_pool_full()) {
+                drop_display_lists(instance, batch->nextBatch);
+                break;
+            }
+            gSPMatrix(gDisplayListHead++, VIRTUAL_TO_PHYSICAL(instance->transform),
+                      (G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH));
+            gSPDisplayList(gDisplayListHead++, instance->displayList);
+        }
+        // The batch is still closed off when it's cut short, so the next layer doesn't inherit its material.
+        if (batch->revertList != NULL) {
+            gSPDisplayList(gDisplayListHead++, batch->revertList);
+        }
+#if SILHOUETTE
+        if (isSilhouette) {
+            gSPDisplayList(gDisplayListHead++, dl_silhouette_end);
+        }
+#endif
+        if (instance != NULL) {
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
 /**
  * Process a master list node. This has been modified, so now it runs twice, for each microcode.
  * It iterates through the first 5 layers of if the first index using F3DLX2.Rej, then it switches
@@ -354,12 +562,16 @@ Mtx identityMatrixWorldScale = {{
 void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
     struct RenderPhase *renderPhase;
     struct DisplayListNode *currList;
+#ifdef SORT_MASTER_LIST_LAYERS
+    struct DisplayListNode *prevList;
+#endif
     s32 currLayer     = LAYER_FIRST;
     s32 startLayer    = LAYER_FIRST;
     s32 endLayer      = LAYER_LAST;
     s32 ucode         = GRAPH_NODE_UCODE_DEFAULT;
     s32 phaseIndex    = RENDER_PHASE_FIRST;
     s32 enableZBuffer = (node->node.flags & GRAPH_RENDER_Z_BUFFER) != 0;
+    s32 poolFull      = FALSE;
     struct RenderModeContainer *mode1List = &renderModeTable_1Cycle[enableZBuffer];
     struct RenderModeContainer *mode2List = &renderModeTable_2Cycle[enableZBuffer];
 
@@ -384,6 +596,17 @@ void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
         for (currLayer = startLayer; currLayer <= endLayer; currLayer++) {
             // Set 'currList' to the first DisplayListNode on the current layer.
             currList = node->listHeads[ucode][currLayer];
+            // Empty layers don't need their render mode set, since the next layer overwrites it before drawing anything.
+            // The very last one still sets it, so the master list leaves the same render mode behind as before.
+            if (currList == NULL && node->instanceBatches[ucode][currLayer] == NULL
+                && (phaseIndex != (RENDER_PHASE_END - 1) || currLayer != endLayer)) {
+                continue;
+            }
+            // Once the Gfx pool fills up, the remaining layers (the transparent ones come last) are dropped for this frame.
+            if (poolFull) {
+                drop_display_lists(currList, node->instanceBatches[ucode][currLayer]);
+                continue;
+            }
 #if defined(DISABLE_AA) || !SILHOUETTE
             // Set the render mode for the current layer.
             gDPSetRenderMode(gDisplayListHead++, mode1List->modes[currLayer],
@@ -399,12 +622,33 @@ void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
                 gDPSetRenderMode(gDisplayListHead++, mode1List->modes[currLayer],
                                                      mode2List->modes[currLayer]);
             }
+#endif
+#ifdef SORT_MASTER_LIST_LAYERS
+            prevList = NULL;
 #endif
             // Iterate through all the displaylists on the current layer.
             while (currList != NULL) {
+                if (is_gfx_pool_full()) {
+                    drop_display_lists(currList, node->instanceBatches[ucode][currLayer]);
+                    poolFull = TRUE;
+                    break;
+                }
+#ifdef SORT_MASTER_LIST_LAYERS
+                // Display lists of the same object that share a transform don't need it loaded again.
+                // Ones outside of objects always load it, since some (like envfx) load their own matrix.
+                if (prevList == NULL
+                    || currList->transform != prevList->transform
+                    || currList->sortKey == 0
+                    || currList->sortKey != prevList->sortKey) {
+                    gSPMatrix(gDisplayListHead++, VIRTUAL_TO_PHYSICAL(currList->transform),
+                              (G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH));
+                }
+                prevList = currList;
+#else
                 // Add the display list's transformation to the master list.
                 gSPMatrix(gDisplayListHead++, VIRTUAL_TO_PHYSICAL(currList->transform),
                           (G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH));
+#endif
 #if SILHOUETTE
                 if (phaseIndex == RENDER_PHASE_SILHOUETTE) {
                     // Add the current display list to the master list, with silhouette F3D.
@@ -422,6 +666,14 @@ void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
                 // Move to the next DisplayListNode.
                 currList = currList->next;
             }
+            if (poolFull) {
+                continue;
+            }
+#if SILHOUETTE
+            poolFull = geo_process_instance_batches(node->instanceBatches[ucode][currLayer], (phaseIndex == RENDER_PHASE_SILHOUETTE));
+#else
+            poolFull = geo_process_instance_batches(node->instanceBatches[ucode][currLayer], FALSE);
+#endif
         }
     }
 
@@ -445,15 +697,41 @@ void geo_process_master_list_sub(struct GraphNodeMasterList *node) {
 }
 
 /**
- * Appends the display list to one of the master lists based on the layer
- * parameter. Look at the RenderModeContainer struct to see the corresponding
- * render modes of layers.
+ * Pushes the matrix that was just written to gMatStack. Its fixed point version isn't made
+ * until a display list needs it (see get_mat_stack_fixed), since many transforms (like the
+ * joints of an animated model) only lead to other transforms and never get drawn with.
  */
-void geo_append_display_list(void *displayList, s32 layer) {
+static void inc_mat_stack() {
+    gMatStackIndex++;
+    gMatStackFixed[gMatStackIndex] = NULL;
+    sMatStackStamps[gMatStackIndex] = 0;
+}
+
+/**
+ * Returns the fixed point version of the current matrix, converting it the first time it's needed.
+ * Returns NULL if the Gfx pool is too full for it.
+ */
+static Mtx *get_mat_stack_fixed(void) {
+    Mtx *mtx = gMatStackFixed[gMatStackIndex];
+
+    if (mtx == NULL) {
+        mtx = alloc_level_display_list(sizeof(*mtx));
+        if (mtx == NULL) {
+            return NULL;
+        }
+        mtxf_to_mtx(mtx, gMatStack[gMatStackIndex]);
+        gMatStackFixed[gMatStackIndex] = mtx;
+    }
+
+    return mtx;
+}
+
+/**
+ * Returns the microcode that the current object's display lists are drawn with,
+ * and moves 'layer' to its silhouette variant if the object has a silhouette.
+ */
+static s32 get_display_list_ucode_and_layer(s32 *layer) {
     s32 ucode = GRAPH_NODE_UCODE_DEFAULT;
-#ifdef F3DEX_GBI_2
-    gSPLookAt(gDisplayListHead++, gCurLookAt);
-#endif
 #if defined(OBJECTS_REJ) || SILHOUETTE
     if (gCurGraphNodeObject != NULL) {
  #ifdef OBJECTS_REJ
@@ -461,27 +739,52 @@ void geo_append_display_list(void *displayList, s32 layer) {
  #endif
  #if SILHOUETTE
         if (gCurGraphNodeObject->node.flags & GRAPH_RENDER_SILHOUETTE) {
-            switch (layer) {
-                case LAYER_OPAQUE: layer = LAYER_SILHOUETTE_OPAQUE; break;
-                case LAYER_ALPHA:  layer = LAYER_SILHOUETTE_ALPHA;  break;
+            switch (*layer) {
+                case LAYER_OPAQUE: *layer = LAYER_SILHOUETTE_OPAQUE; break;
+                case LAYER_ALPHA:  *layer = LAYER_SILHOUETTE_ALPHA;  break;
             }
         }
         if (gCurGraphNodeObject->node.flags & GRAPH_RENDER_OCCLUDE_SILHOUETTE) {
-            switch (layer) {
-                case LAYER_OPAQUE: layer = LAYER_OCCLUDE_SILHOUETTE_OPAQUE; break;
-                case LAYER_ALPHA:  layer = LAYER_OCCLUDE_SILHOUETTE_ALPHA;  break;
+            switch (*layer) {
+                case LAYER_OPAQUE: *layer = LAYER_OCCLUDE_SILHOUETTE_OPAQUE; break;
+                case LAYER_ALPHA:  *layer = LAYER_OCCLUDE_SILHOUETTE_ALPHA;  break;
             }
         }
  #endif // SILHOUETTE
     }
 #endif // F3DEX_GBI_2 || SILHOUETTE
+    return ucode;
+}
+
+/**
+ * Appends the display list to one of the master lists based on the layer
+ * parameter. Look at the RenderModeContainer struct to see the corresponding
+ * render modes of layers.
+ */
+void geo_append_display_list(void *displayList, s32 layer) {
+    if (is_gfx_pool_full()) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.gfx_dropped_lists);
+        return;
+    }
+#ifdef F3DEX_GBI_2
+    gSPLookAt(gDisplayListHead++, gCurLookAt);
+#endif
+    s32 ucode = get_display_list_ucode_and_layer(&layer);
     if (gCurGraphNodeMasterList != NULL) {
+        Mtx *transform = get_mat_stack_fixed();
+        if (transform == NULL) {
+            return;
+        }
+
         struct DisplayListNode *listNode =
             alloc_only_pool_alloc(gDisplayListHeap, sizeof(struct DisplayListNode));
 
-        listNode->transform = gMatStackFixed[gMatStackIndex];
+        listNode->transform = transform;
         listNode->displayList = displayList;
         listNode->next = NULL;
+#ifdef SORT_MASTER_LIST_LAYERS
+        listNode->sortKey = ((gCurGraphNodeObject != NULL) ? (uintptr_t) gCurGraphNodeObject->sharedChild : 0);
+#endif
         if (gCurGraphNodeMasterList->listHeads[ucode][layer] == NULL) {
             gCurGraphNodeMasterList->listHeads[ucode][layer] = listNode;
         } else {
@@ -491,13 +794,6 @@ void geo_append_display_list(void *displayList, s32 layer) {
     }
 }
 
-static void inc_mat_stack() {
-    Mtx *mtx = alloc_display_list(sizeof(*mtx));
-    gMatStackIndex++;
-    mtxf_to_mtx(mtx, gMatStack[gMatStackIndex]);
-    gMatStackFixed[gMatStackIndex] = mtx;
-}
-
 static void append_dl_and_return(struct GraphNodeDisplayList *node) {
     if (node->displayList != NULL) {
         geo_append_display_list(node->displayList, GET_GRAPH_NODE_LAYER(node->node.flags));
@@ -519,9 +815,14 @@ void geo_process_master_list(struct GraphNodeMasterList *node) {
         for (ucode = 0; ucode < GRAPH_NODE_NUM_UCODES; ucode++) {
             for (layer = LAYER_FIRST; layer < LAYER_COUNT; layer++) {
                 node->listHeads[ucode][layer] = NULL;
+                node->instanceBatches[ucode][layer] = NULL;
             }
         }
+        sMasterListCounter++;
         geo_process_node_and_siblings(node->node.children);
+#ifdef SORT_MASTER_LIST_LAYERS
+        sort_master_list_layers(gCurGraphNodeMasterList);
+#endif
         geo_process_master_list_sub(gCurGraphNodeMasterList);
         gCurGraphNodeMasterList = NULL;
     }
@@ -724,6 +1025,52 @@ void geo_process_camera(struct GraphNodeCamera *node) {
     }
 }
 
+/**
+ * Pushes a transform node's matrix from its cache, if the node has one, and neither the node's parameters
+ * nor its parent's matrix have changed since it was computed. Returns FALSE if the caller has to compute it.
+ */
+static s32 push_cached_matrix(struct GraphNodeMatrixCache *cache, Vec3s translation, Vec3s rotation, f32 scale) {
+    if (cache == NULL
+        || sMatStackStamps[gMatStackIndex] == 0
+        || cache->parentStamp != sMatStackStamps[gMatStackIndex]
+        || !vec3_equal(cache->translation, translation)
+        || !vec3_equal(cache->rotation, rotation)
+        || cache->scale != scale) {
+        return FALSE;
+    }
+
+    gMatStackIndex++;
+    mtxf_copy(gMatStack[gMatStackIndex], cache->matrix);
+    if (!cache->fixedMatrixValid) {
+        mtxf_to_mtx(&cache->fixedMatrix, cache->matrix);
+        cache->fixedMatrixValid = TRUE;
+    }
+    gMatStackFixed[gMatStackIndex] = &cache->fixedMatrix;
+    sMatStackStamps[gMatStackIndex] = cache->stamp;
+    return TRUE;
+}
+
+/**
+ * Stores the matrix that was just pushed in a transform node's cache, if its parent's matrix is static.
+ * The cached fixed point matrix isn't used until the next frame, so this frame still converts its own.
+ * That also means it's only ever rewritten a frame after the last one that read it, which has already been
+ * fenced by the time the frame after that is built, so it's safe to share with the RCP.
+ */
+static void store_cached_matrix(struct GraphNodeMatrixCache *cache, Vec3s translation, Vec3s rotation, f32 scale) {
+    if (cache == NULL || sMatStackStamps[gMatStackIndex - 1] == 0) {
+        return;
+    }
+
+    mtxf_copy(cache->matrix, gMatStack[gMatStackIndex]);
+    vec3s_copy(cache->translation, translation);
+    vec3s_copy(cache->rotation, rotation);
+    cache->scale = scale;
+    cache->parentStamp = sMatStackStamps[gMatStackIndex - 1];
+    cache->stamp = ++sMatrixCacheStamp;
+    cache->fixedMatrixValid = FALSE;
+    sMatStackStamps[gMatStackIndex] = cache->stamp;
+}
+
 /**
  * Process a translation / rotation node. A transformation matrix based
  * on the node's translation and rotation is created and pushed on both
@@ -733,10 +1080,13 @@ void geo_process_camera(struct GraphNodeCamera *node) {
 void geo_process_translation_rotation(struct GraphNodeTranslationRotation *node) {
     Vec3f translation;
 
-    vec3s_to_vec3f(translation, node->translation);
-    mtxf_rotate_zxy_and_translate_and_mul(node->rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    if (!push_cached_matrix(node->matrixCache, node->translation, node->rotation, 1.0f)) {
+        vec3s_to_vec3f(translation, node->translation);
+        mtxf_rotate_zxy_and_translate_and_mul(node->rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
 
-    inc_mat_stack();
+        inc_mat_stack();
+        store_cached_matrix(node->matrixCache, node->translation, node->rotation, 1.0f);
+    }
     append_dl_and_return((struct GraphNodeDisplayList *)node);
 }
 
@@ -748,10 +1098,13 @@ void geo_process_translation_rotation(struct GraphNodeTranslationRotation *node)
 void geo_process_translation(struct GraphNodeTranslation *node) {
     Vec3f translation;
 
-    vec3s_to_vec3f(translation, node->translation);
-    mtxf_rotate_zxy_and_translate_and_mul(gVec3sZero, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    if (!push_cached_matrix(node->matrixCache, node->translation, gVec3sZero, 1.0f)) {
+        vec3s_to_vec3f(translation, node->translation);
+        mtxf_rotate_zxy_and_translate_and_mul(gVec3sZero, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
 
-    inc_mat_stack();
+        inc_mat_stack();
+        store_cached_matrix(node->matrixCache, node->translation, gVec3sZero, 1.0f);
+    }
     append_dl_and_return((struct GraphNodeDisplayList *)node);
 }
 
@@ -761,9 +1114,12 @@ void geo_process_translation(struct GraphNodeTranslation *node) {
  * For the rest it acts as a normal display list node.
  */
 void geo_process_rotation(struct GraphNodeRotation *node) {
-    mtxf_rotate_zxy_and_translate_and_mul(node->rotation, gVec3fZero, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
+    if (!push_cached_matrix(node->matrixCache, gVec3sZero, node->rotation, 1.0f)) {
+        mtxf_rotate_zxy_and_translate_and_mul(node->rotation, gVec3fZero, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
 
-    inc_mat_stack();
+        inc_mat_stack();
+        store_cached_matrix(node->matrixCache, gVec3sZero, node->rotation, 1.0f);
+    }
     append_dl_and_return(((struct GraphNodeDisplayList *)node));
 }
 
@@ -775,10 +1131,13 @@ void geo_process_rotation(struct GraphNodeRotation *node) {
 void geo_process_scale(struct GraphNodeScale *node) {
     Vec3f scaleVec;
 
-    vec3f_set(scaleVec, node->scale, node->scale, node->scale);
-    mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex], scaleVec);
+    if (!push_cached_matrix(node->matrixCache, gVec3sZero, gVec3sZero, node->scale)) {
+        vec3f_set(scaleVec, node->scale, node->scale, node->scale);
+        mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex], scaleVec);
 
-    inc_mat_stack();
+        inc_mat_stack();
+        store_cached_matrix(node->matrixCache, gVec3sZero, gVec3sZero, node->scale);
+    }
     append_dl_and_return((struct GraphNodeDisplayList *)node);
 }
 
@@ -817,6 +1176,67 @@ void geo_process_display_list(struct GraphNodeDisplayList *node) {
     gMatStackIndex++;
 }
 
+/**
+ * Process an instanced display list node. The current transform is added to the node's instances,
+ * and the node is added to its layer's batches the first time it's reached in this master list pass.
+ * If it's reached again with a different layer or microcode (such as from an object with a silhouette),
+ * that instance is drawn on its own instead.
+ */
+void geo_process_instanced_display_list(struct GraphNodeInstancedDisplayList *node) {
+    s32 layer = GET_GRAPH_NODE_LAYER(node->node.flags);
+    s32 ucode = get_display_list_ucode_and_layer(&layer);
+
+    if (gCurGraphNodeMasterList != NULL && node->geometryList != NULL) {
+        if (node->batchCounter != sMasterListCounter) {
+            node->batchCounter = sMasterListCounter;
+            node->batchLayer = layer;
+            node->batchUcode = ucode;
+            node->instanceHead = NULL;
+            node->nextBatch = gCurGraphNodeMasterList->instanceBatches[ucode][layer];
+            gCurGraphNodeMasterList->instanceBatches[ucode][layer] = node;
+        }
+
+        if (node->batchLayer == layer && node->batchUcode == ucode) {
+            Mtx *transform = get_mat_stack_fixed();
+
+            if (transform != NULL) {
+                struct DisplayListNode *instance =
+                    alloc_only_pool_alloc(gDisplayListHeap, sizeof(struct DisplayListNode));
+
+                instance->transform = transform;
+                instance->displayList = node->geometryList;
+                instance->next = NULL;
+                if (node->instanceHead == NULL) {
+                    node->instanceHead = instance;
+                } else {
+                    node->instanceTail->next = instance;
+                }
+                node->instanceTail = instance;
+            }
+        } else {
+            Gfx *dlStart = alloc_level_display_list(4 * sizeof(Gfx));
+
+            if (dlStart != NULL) {
+                Gfx *dlHead = dlStart;
+
+                if (node->materialList != NULL) {
+                    gSPDisplayList(dlHead++, node->materialList);
+                }
+                gSPDisplayList(dlHead++, node->geometryList);
+                if (node->revertList != NULL) {
+                    gSPDisplayList(dlHead++, node->revertList);
+                }
+                gSPEndDisplayList(dlHead);
+                geo_append_display_list(dlStart, GET_GRAPH_NODE_LAYER(node->node.flags));
+            }
+        }
+    }
+
+    if (node->node.children != NULL) {
+        geo_process_node_and_siblings(node->node.children);
+    }
+}
+
 /**
  * Process a generated list. Instead of storing a pointer to a display list,
  * the list is generated on the fly by a function.
@@ -872,6 +1292,82 @@ void geo_process_background(struct GraphNodeBackground *node) {
     }
 }
 
+#ifdef ANIMATION_POSE_CACHE
+/**
+ * Drops the cached poses of an animation whose data was replaced (like Mario's, which are all loaded into the same
+ * buffer), or of every animation if 'anim' is NULL.
+ */
+void anim_pose_cache_invalidate(struct Animation *anim) {
+    for (s32 i = 0; i < ANIM_POSE_CACHE_SIZE; i++) {
+        if (anim == NULL || sAnimPoseCache[i].anim == anim) {
+            sAnimPoseCache[i].anim = NULL;
+        }
+    }
+}
+
+/**
+ * Finds the cached pose of the current animation at a frame, or takes over the slot it belongs in.
+ * Neighbouring frames of an animation go in neighbouring slots.
+ */
+static struct AnimPose *get_anim_pose(s16 frame) {
+    struct AnimPose *pose = &sAnimPoseCache[(((uintptr_t) sCurrAnim >> 4) + frame) & (ANIM_POSE_CACHE_SIZE - 1)];
+
+    if (pose->anim != sCurrAnim || pose->frame != frame) {
+        pose->anim = sCurrAnim;
+        pose->frame = frame;
+        pose->numValues = 0;
+    }
+    return pose;
+}
+
+/**
+ * Returns the value of an attribute in a pose, decoding the pose up to it first if it hasn't been yet.
+ */
+static s32 get_anim_pose_value(struct AnimPose *pose, s32 attribute) {
+    if (attribute < pose->numValues) {
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.anim_pose_reused);
+        return pose->values[attribute];
+    }
+
+    while (pose->numValues <= attribute) {
+        u16 *index = &sCurrAnimIndex[pose->numValues * 2];
+        pose->values[pose->numValues++] = gCurrAnimData[retrieve_animation_index(pose->frame, &index)];
+        PUPPYPRINT_ADD_COUNTER(gPuppyCallCounter.anim_pose_decoded);
+    }
+    return pose->values[attribute];
+}
+#endif
+
+/**
+ * Returns the value of the current animation attribute at the current frame, and moves on to the next attribute.
+ */
+static s32 geo_get_anim_value(void) {
+#ifdef ANIMATION_POSE_CACHE
+    s32 attribute = ((gCurrAnimAttribute - sCurrAnimIndex) / 2);
+
+    if (attribute < ANIM_POSE_MAX_VALUES) {
+        gCurrAnimAttribute += 2;
+        if (sCurrAnimPose == NULL) {
+            sCurrAnimPose = get_anim_pose(gCurrAnimFrame);
+        }
+        s32 value = get_anim_pose_value(sCurrAnimPose, attribute);
+ #ifdef ANIMATION_FRAME_INTERPOLATION
+        if (sCurrAnimBlend != 0) {
+            if (sCurrAnimNextPose == NULL) {
+                sCurrAnimNextPose = get_anim_pose(sCurrAnimNextFrame);
+            }
+            // Blending the difference as an s16 takes angles the short way around.
+            // Translations never move far enough in a frame for it to make a difference to them.
+            s16 delta = (get_anim_pose_value(sCurrAnimNextPose, attribute) - value);
+            value += ((delta * (s32) sCurrAnimBlend) >> 16);
+        }
+ #endif
+        return value;
+    }
+#endif
+    return gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
+}
+
 /**
  * Render an animated part. The current animation state is not part of the node
  * but set in global variables. If an animated part is skipped, everything afterwards desyncs.
@@ -881,28 +1377,28 @@ void geo_process_animated_part(struct GraphNodeAnimatedPart *node) {
     Vec3f translation = { node->translation[0], node->translation[1], node->translation[2] };
 
     if (gCurrAnimType == ANIM_TYPE_TRANSLATION) {
-        translation[0] += gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
+        translation[0] += geo_get_anim_value()
                           * gCurrAnimTranslationMultiplier;
-        translation[1] += gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
+        translation[1] += geo_get_anim_value()
                           * gCurrAnimTranslationMultiplier;
-        translation[2] += gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
+        translation[2] += geo_get_anim_value()
                           * gCurrAnimTranslationMultiplier;
         gCurrAnimType = ANIM_TYPE_ROTATION;
     } else {
         if (gCurrAnimType == ANIM_TYPE_LATERAL_TRANSLATION) {
             translation[0] +=
-                gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
+                geo_get_anim_value()
                 * gCurrAnimTranslationMultiplier;
             gCurrAnimAttribute += 2;
             translation[2] +=
-                gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
+                geo_get_anim_value()
                 * gCurrAnimTranslationMultiplier;
             gCurrAnimType = ANIM_TYPE_ROTATION;
         } else {
             if (gCurrAnimType == ANIM_TYPE_VERTICAL_TRANSLATION) {
                 gCurrAnimAttribute += 2;
                 translation[1] +=
-                    gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)]
+                    geo_get_anim_value()
                     * gCurrAnimTranslationMultiplier;
                 gCurrAnimAttribute += 2;
                 gCurrAnimType = ANIM_TYPE_ROTATION;
@@ -914,9 +1410,9 @@ void geo_process_animated_part(struct GraphNodeAnimatedPart *node) {
     }
 
     if (gCurrAnimType == ANIM_TYPE_ROTATION) {
-        rotation[0] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
-        rotation[1] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
-        rotation[2] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)];
+        rotation[0] = geo_get_anim_value();
+        rotation[1] = geo_get_anim_value();
+        rotation[2] = geo_get_anim_value();
     }
 
     mtxf_rotate_xyz_and_translate_and_mul(rotation, translation, gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex]);
@@ -950,6 +1446,28 @@ void geo_set_animation_globals(struct AnimInfo *node, s32 hasAnimation) {
     gCurrAnimEnabled = (anim->flags & ANIM_FLAG_DISABLED) == 0;
     gCurrAnimAttribute = segmented_to_virtual((void *) anim->index);
     gCurrAnimData = segmented_to_virtual((void *) anim->values);
+#ifdef ANIMATION_POSE_CACHE
+    sCurrAnim = anim;
+    sCurrAnimIndex = gCurrAnimAttribute;
+    sCurrAnimPose = NULL;
+ #ifdef ANIMATION_FRAME_INTERPOLATION
+    sCurrAnimNextPose = NULL;
+    sCurrAnimBlend = 0;
+    // The fraction of the frame is only kept while the animation is accelerated, and otherwise stays 0.
+    if (!(anim->flags & ANIM_FLAG_NO_ACCEL) && (node->animFrameAccelAssist >> 16) == node->animFrame) {
+        s32 nextFrame = (node->animFrame + 1);
+
+        if (nextFrame >= anim->loopEnd) {
+            nextFrame = (anim->flags & ANIM_FLAG_NOLOOP) ? node->animFrame : anim->loopStart;
+        }
+        // Frames a multiple of the cache size apart would fight over the same slot.
+        if ((nextFrame - node->animFrame) & (ANIM_POSE_CACHE_SIZE - 1)) {
+            sCurrAnimNextFrame = nextFrame;
+            sCurrAnimBlend = (node->animFrameAccelAssist & 0xFFFF);
+        }
+    }
+ #endif
+#endif
 
     if (anim->animYTransDivisor == 0) {
         gCurrAnimTranslationMultiplier = 1.0f;
@@ -991,10 +1509,10 @@ void geo_process_shadow(struct GraphNodeShadow *node) {
 
             f32 animScale = gCurrAnimTranslationMultiplier * objScale;
             Vec3f animOffset;
-            animOffset[0] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)] * animScale;
+            animOffset[0] = geo_get_anim_value() * animScale;
             animOffset[1] = 0.0f;
             gCurrAnimAttribute += 2;
-            animOffset[2] = gCurrAnimData[retrieve_animation_index(gCurrAnimFrame, &gCurrAnimAttribute)] * animScale;
+            animOffset[2] = geo_get_anim_value() * animScale;
             gCurrAnimAttribute -= 6;
 
             // simple matrix rotation so the shadow offset rotates along with the object
@@ -1005,8 +1523,10 @@ void geo_process_shadow(struct GraphNodeShadow *node) {
             shadowPos[2] += -animOffset[0] * sinAng + animOffset[2] * cosAng;
         }
 
+        GFX_POOL_PUSH_USER(GFX_POOL_USER_SHADOWS);
         Gfx *shadowList = create_shadow_below_xyz(shadowPos, shadowScale * 0.5f,
                                                   node->shadowSolidity, node->shadowType, shifted);
+        GFX_POOL_POP_USER();
 
         if (shadowList != NULL) {
             mtxf_shadow(gMatStack[gMatStackIndex + 1],
@@ -1147,36 +1667,48 @@ void visualise_object_hitbox(struct Object *node) {
  */
 void geo_process_object(struct Object *node) {
     if (node->header.gfx.areaIndex == gCurGraphNodeRoot->areaIndex) {
-        s32 isInvisible = (node->header.gfx.node.flags & GRAPH_RENDER_INVISIBLE);
+        // Objects in a room that can't be seen from Mario's room or the camera's are skipped like invisible ones.
+        s32 isInvisible = ((node->header.gfx.node.flags & GRAPH_RENDER_INVISIBLE) || !is_room_visible(node->oRoom));
         s32 noThrowMatrix = (node->header.gfx.throwMatrix == NULL);
+        s32 isInView;
+
+        if (noThrowMatrix) {
+            // Without a throw matrix, the object's translation is known before its matrix is built, so it can be
+            // culled first and skip the rotation, scale and billboard work. This is the same translation the
+            // matrix below would end up with.
+            Vec3f worldPos;
+            vec3f_copy(worldPos, node->header.gfx.pos);
+            if (!isInvisible && (node->header.gfx.node.flags & GRAPH_RENDER_BILLBOARD)) {
+                vec3f_add(worldPos, gMatStack[gMatStackIndex][3]);
+            }
+            linear_mtxf_mul_vec3f_and_translate(gCameraTransform, node->header.gfx.cameraToObject, worldPos);
+            isInView = (!isInvisible && obj_is_in_view(&node->header.gfx));
 
-        // If the throw matrix is null and the object is invisible, there is no need
-        // to update billboarding, scale, rotation, etc. 
-        // This still updates translation since it is needed for sound.
-        if (isInvisible && noThrowMatrix) {
-            mtxf_translate(gMatStack[gMatStackIndex + 1], node->header.gfx.pos);
-        }
-        else{
-            if (!noThrowMatrix) {
-                mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], *node->header.gfx.throwMatrix, node->header.gfx.scale);
-            } else if (node->header.gfx.node.flags & GRAPH_RENDER_BILLBOARD) {
-                mtxf_billboard(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex],
-                            node->header.gfx.pos, node->header.gfx.scale, gCurGraphNodeCamera->roll);
-            } else {
-                mtxf_rotate_zxy_and_translate(gMatStack[gMatStackIndex + 1], node->header.gfx.pos, node->header.gfx.angle);
-                mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex + 1], node->header.gfx.scale);
+            if (isInView) {
+                if (node->header.gfx.node.flags & GRAPH_RENDER_BILLBOARD) {
+                    mtxf_billboard(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex],
+                                node->header.gfx.pos, node->header.gfx.scale, gCurGraphNodeCamera->roll);
+                } else {
+                    mtxf_rotate_zxy_and_translate(gMatStack[gMatStackIndex + 1], node->header.gfx.pos, node->header.gfx.angle);
+                    mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], gMatStack[gMatStackIndex + 1], node->header.gfx.scale);
+                }
             }
-        }
 
-        node->header.gfx.throwMatrix = &gMatStack[++gMatStackIndex];
-        linear_mtxf_mul_vec3f_and_translate(gCameraTransform, node->header.gfx.cameraToObject, (*node->header.gfx.throwMatrix)[3]);
+            node->header.gfx.throwMatrix = &gMatStack[++gMatStackIndex];
+        } else {
+            mtxf_scale_vec3f(gMatStack[gMatStackIndex + 1], *node->header.gfx.throwMatrix, node->header.gfx.scale);
+
+            node->header.gfx.throwMatrix = &gMatStack[++gMatStackIndex];
+            linear_mtxf_mul_vec3f_and_translate(gCameraTransform, node->header.gfx.cameraToObject, (*node->header.gfx.throwMatrix)[3]);
+            isInView = (!isInvisible && obj_is_in_view(&node->header.gfx));
+        }
 
         // FIXME: correct types
         if (node->header.gfx.animInfo.curAnim != NULL) {
             geo_set_animation_globals(&node->header.gfx.animInfo, (node->header.gfx.node.flags & GRAPH_RENDER_HAS_ANIMATION) != 0);
         }
 
-        if (!isInvisible && obj_is_in_view(&node->header.gfx)) {
+        if (isInView) {
             gMatStackIndex--;
             inc_mat_stack();
 
@@ -1253,6 +1785,14 @@ void geo_process_held_object(struct GraphNodeHeldObject *node) {
         gGeoTempState.translationMultiplier = gCurrAnimTranslationMultiplier;
         gGeoTempState.attribute = gCurrAnimAttribute;
         gGeoTempState.data = gCurrAnimData;
+#ifdef ANIMATION_POSE_CACHE
+        gGeoTempState.anim = sCurrAnim;
+        gGeoTempState.index = sCurrAnimIndex;
+ #ifdef ANIMATION_FRAME_INTERPOLATION
+        gGeoTempState.nextFrame = sCurrAnimNextFrame;
+        gGeoTempState.blend = sCurrAnimBlend;
+ #endif
+#endif
         gCurrAnimType = ANIM_TYPE_NONE;
         gCurGraphNodeHeldObject = (void *) node;
         if (node->objNode->header.gfx.animInfo.curAnim != NULL) {
@@ -1267,6 +1807,17 @@ void geo_process_held_object(struct GraphNodeHeldObject *node) {
         gCurrAnimTranslationMultiplier = gGeoTempState.translationMultiplier;
         gCurrAnimAttribute = gGeoTempState.attribute;
         gCurrAnimData = gGeoTempState.data;
+#ifdef ANIMATION_POSE_CACHE
+        // The held object's poses may have taken over the slots of the holder's, so they're looked up again.
+        sCurrAnim = gGeoTempState.anim;
+        sCurrAnimIndex = gGeoTempState.index;
+        sCurrAnimPose = NULL;
+ #ifdef ANIMATION_FRAME_INTERPOLATION
+        sCurrAnimNextPose = NULL;
+        sCurrAnimNextFrame = gGeoTempState.nextFrame;
+        sCurrAnimBlend = gGeoTempState.blend;
+ #endif
+#endif
         gMatStackIndex--;
     }
 
@@ -1288,28 +1839,29 @@ typedef void (*GeoProcessFunc)();
 
 // See enum 'GraphNodeTypes' in 'graph_node.h'.
 static GeoProcessFunc GeoProcessJumpTable[] = {
-    [GRAPH_NODE_TYPE_ORTHO_PROJECTION    ] = geo_process_ortho_projection,
-    [GRAPH_NODE_TYPE_PERSPECTIVE         ] = geo_process_perspective,
-    [GRAPH_NODE_TYPE_MASTER_LIST         ] = geo_process_master_list,
-    [GRAPH_NODE_TYPE_LEVEL_OF_DETAIL     ] = geo_process_level_of_detail,
-    [GRAPH_NODE_TYPE_SWITCH_CASE         ] = geo_process_switch,
-    [GRAPH_NODE_TYPE_CAMERA              ] = geo_process_camera,
-    [GRAPH_NODE_TYPE_TRANSLATION_ROTATION] = geo_process_translation_rotation,
-    [GRAPH_NODE_TYPE_TRANSLATION         ] = geo_process_translation,
-    [GRAPH_NODE_TYPE_ROTATION            ] = geo_process_rotation,
-    [GRAPH_NODE_TYPE_OBJECT              ] = geo_process_object,
-    [GRAPH_NODE_TYPE_ANIMATED_PART       ] = geo_process_animated_part,
-    [GRAPH_NODE_TYPE_BILLBOARD           ] = geo_process_billboard,
-    [GRAPH_NODE_TYPE_DISPLAY_LIST        ] = geo_process_display_list,
-    [GRAPH_NODE_TYPE_SCALE               ] = geo_process_scale,
-    [GRAPH_NODE_TYPE_SHADOW              ] = geo_process_shadow,
-    [GRAPH_NODE_TYPE_OBJECT_PARENT       ] = geo_process_object_parent,
-    [GRAPH_NODE_TYPE_GENERATED_LIST      ] = geo_process_generated_list,
-    [GRAPH_NODE_TYPE_BACKGROUND          ] = geo_process_background,
-    [GRAPH_NODE_TYPE_HELD_OBJ            ] = geo_process_held_object,
-    [GRAPH_NODE_TYPE_CULLING_RADIUS      ] = geo_try_process_children,
-    [GRAPH_NODE_TYPE_ROOT                ] = geo_try_process_children,
-    [GRAPH_NODE_TYPE_START               ] = geo_try_process_children,
+    [GRAPH_NODE_TYPE_ORTHO_PROJECTION      ] = geo_process_ortho_projection,
+    [GRAPH_NODE_TYPE_PERSPECTIVE           ] = geo_process_perspective,
+    [GRAPH_NODE_TYPE_MASTER_LIST           ] = geo_process_master_list,
+    [GRAPH_NODE_TYPE_LEVEL_OF_DETAIL       ] = geo_process_level_of_detail,
+    [GRAPH_NODE_TYPE_SWITCH_CASE           ] = geo_process_switch,
+    [GRAPH_NODE_TYPE_CAMERA                ] = geo_process_camera,
+    [GRAPH_NODE_TYPE_TRANSLATION_ROTATION  ] = geo_process_translation_rotation,
+    [GRAPH_NODE_TYPE_TRANSLATION           ] = geo_process_translation,
+    [GRAPH_NODE_TYPE_ROTATION              ] = geo_process_rotation,
+    [GRAPH_NODE_TYPE_OBJECT                ] = geo_process_object,
+    [GRAPH_NODE_TYPE_ANIMATED_PART         ] = geo_process_animated_part,
+    [GRAPH_NODE_TYPE_BILLBOARD             ] = geo_process_billboard,
+    [GRAPH_NODE_TYPE_DISPLAY_LIST          ] = geo_process_display_list,
+    [GRAPH_NODE_TYPE_SCALE                 ] = geo_process_scale,
+    [GRAPH_NODE_TYPE_SHADOW                ] = geo_process_shadow,
+    [GRAPH_NODE_TYPE_OBJECT_PARENT         ] = geo_process_object_parent,
+    [GRAPH_NODE_TYPE_GENERATED_LIST        ] = geo_process_generated_list,
+    [GRAPH_NODE_TYPE_BACKGROUND            ] = geo_process_background,
+    [GRAPH_NODE_TYPE_HELD_OBJ              ] = geo_process_held_object,
+    [GRAPH_NODE_TYPE_CULLING_RADIUS        ] = geo_try_process_children,
+    [GRAPH_NODE_TYPE_INSTANCED_DISPLAY_LIST] = geo_process_instanced_display_list,
+    [GRAPH_NODE_TYPE_ROOT                  ] = geo_try_process_children,
+    [GRAPH_NODE_TYPE_START                 ] = geo_try_process_children,
 };
 
 /**
@@ -1377,6 +1929,8 @@ void geo_process_root(struct GraphNodeRoot *node, Vp *b, Vp *c, s32 clearColor)
         mtxf_identity(gMatStack[gMatStackIndex]);
         mtxf_to_mtx(initialMatrix, gMatStack[gMatStackIndex]);
         gMatStackFixed[gMatStackIndex] = initialMatrix;
+        // The identity matrix never changes, so it always has the first stamp.
+        sMatStackStamps[gMatStackIndex] = 1;
         gSPViewport(gDisplayListHead++, VIRTUAL_TO_PHYSICAL(viewport));
         gSPMatrix(gDisplayListHead++, VIRTUAL_TO_PHYSICAL(gMatStackFixed[gMatStackIndex]),
                   G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH);
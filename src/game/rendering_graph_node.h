@@ -96,5 +96,10 @@ struct RenderModeContainer {
 
 void geo_process_node_and_siblings(struct GraphNode *firstNode);
 void geo_process_root(struct GraphNodeRoot *node, Vp *b, Vp *c, s32 clearColor);
+#ifdef ANIMATION_POSE_CACHE
+void anim_pose_cache_invalidate(struct Animation *anim);
+#else
+#define anim_pose_cache_invalidate(anim)
+#endif
 
 #endif // RENDERING_GRAPH_NODE_H
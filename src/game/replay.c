@@ -0,0 +1,203 @@
+#include <ultra64.h>
+
+#include "sm64.h"
+#include "area.h"
+#include "engine/math_util.h"
+#include "game_init.h"
+#include "profiling.h"
+#include "puppyprint.h"
+#include "replay.h"
+
+#include "config.h"
+
+#ifdef INPUT_REPLAY
+
+u8 gReplayState = REPLAY_STATE_IDLE;
+u8 gReplayHeadless = FALSE;
+
+static struct ReplayHeader sReplayHeader;
+static struct ReplayInput sReplayInputs[INPUT_REPLAY_BUFFER_SIZE];
+static u16 sReplayInputIndex;
+static u8 sReplayInputFrame;
+static u16 sReplayPrevButton;
+static u32 sReplayNumFrames;
+static OSTime sReplayStartTime;
+
+#ifdef USE_PROFILER
+// The CPU phases that are totalled up over a playback, from PROFILER_TIME_CONTROLLERS to PROFILER_TIME_CAMERA.
+#define REPLAY_NUM_PHASES ((PROFILER_TIME_CAMERA - PROFILER_TIME_CONTROLLERS) + 1)
+
+static const char *sReplayPhaseNames[REPLAY_NUM_PHASES] = {
+    "Input", "Spawner", "Dynamic", "Behavior (before Mario)", "Mario", "Behavior (after Mario)", "Graph", "Collision", "Camera",
+};
+static u64 sReplayPhaseTotals[REPLAY_NUM_PHASES];
+#endif
+
+static void replay_stop_recording(void) {
+    gReplayState = REPLAY_STATE_IDLE;
+    append_puppyprint_log("Replay recorded, %d input runs.", sReplayHeader.numInputs);
+}
+
+/**
+ * Prints how long the playback took, along with the total time spent in each profiler phase.
+ */
+static void replay_finish_playback(void) {
+    gReplayState = REPLAY_STATE_IDLE;
+    gReplayHeadless = FALSE;
+    append_puppyprint_log("Replay finished, %d frames in %dms.",
+                          sReplayNumFrames, (s32)(OS_CYCLES_TO_USEC(osGetTime() - sReplayStartTime) / 1000));
+#ifdef USE_PROFILER
+    for (s32 i = 0; i < REPLAY_NUM_PHASES; i++) {
+        append_puppyprint_log(" %s: %d" PP_CYCLE_STRING " total, %d" PP_CYCLE_STRING " per frame.", sReplayPhaseNames[i],
+                              (s32)PP_CYCLE_CONV(sReplayPhaseTotals[i]), (s32)PP_CYCLE_CONV(sReplayPhaseTotals[i] / MAX(sReplayNumFrames, 1)));
+    }
+#endif
+}
+
+/**
+ * L + D-pad Left toggles recording, L + D-pad Right toggles playback, and L + D-pad Down toggles headless playback.
+ */
+static void replay_handle_controls(u16 pressed) {
+    if (pressed & L_JPAD) {
+        if (gReplayState == REPLAY_STATE_RECORDING) {
+            replay_stop_recording();
+        } else if (gReplayState == REPLAY_STATE_RECORD_ARMED) {
+            gReplayState = REPLAY_STATE_IDLE;
+        } else if (gReplayState == REPLAY_STATE_IDLE) {
+            gReplayState = REPLAY_STATE_RECORD_ARMED;
+            append_puppyprint_log("Replay will record from the next level load.");
+        }
+    } else if (pressed & (R_JPAD | D_JPAD)) {
+        if (gReplayState == REPLAY_STATE_PLAYING) {
+            replay_finish_playback();
+        } else if (gReplayState == REPLAY_STATE_PLAYBACK_ARMED) {
+            gReplayState = REPLAY_STATE_IDLE;
+        } else if (gReplayState == REPLAY_STATE_IDLE) {
+            if (sReplayHeader.numInputs == 0) {
+                append_puppyprint_log("No replay has been recorded.");
+                return;
+            }
+            gReplayState = REPLAY_STATE_PLAYBACK_ARMED;
+            gReplayHeadless = ((pressed & D_JPAD) != 0);
+            append_puppyprint_log("Replay will play from the next load of level %d.", sReplayHeader.levelNum);
+        }
+    }
+}
+
+static void replay_record_input(OSContPadEx *pad) {
+    struct ReplayInput *input;
+
+    // Extend the last run if nothing changed.
+    if (sReplayHeader.numInputs > 0) {
+        input = &sReplayInputs[sReplayHeader.numInputs - 1];
+        if (input->button == pad->button
+            && input->stickX == pad->stick_x
+            && input->stickY == pad->stick_y
+            && input->lTrig == pad->l_trig
+            && input->rTrig == pad->r_trig
+            && input->frames < 0xFF) {
+            input->frames++;
+            return;
+        }
+    }
+
+    if (sReplayHeader.numInputs >= INPUT_REPLAY_BUFFER_SIZE) {
+        append_puppyprint_log("Replay buffer is full.");
+        replay_stop_recording();
+        return;
+    }
+
+    input = &sReplayInputs[sReplayHeader.numInputs++];
+    input->button = pad->button;
+    input->stickX = pad->stick_x;
+    input->stickY = pad->stick_y;
+    input->lTrig = pad->l_trig;
+    input->rTrig = pad->r_trig;
+    input->frames = 1;
+}
+
+static void replay_play_input(OSContPadEx *pad) {
+    struct ReplayInput *input = &sReplayInputs[sReplayInputIndex];
+
+    pad->button = input->button;
+    pad->stick_x = input->stickX;
+    pad->stick_y = input->stickY;
+    pad->l_trig = input->lTrig;
+    pad->r_trig = input->rTrig;
+
+    if (++sReplayInputFrame >= input->frames) {
+        sReplayInputIndex++;
+        sReplayInputFrame = 0;
+    }
+}
+
+/**
+ * Records player 1's raw pad data, or replaces it with the recording. Called once per frame, before the pad data
+ * is read into the controller struct, so everything downstream sees the same inputs either way.
+ */
+void replay_update_inputs(OSContPadEx *pad) {
+    u16 pressed = (pad->button & ~sReplayPrevButton);
+    sReplayPrevButton = pad->button;
+
+    if ((pad->button & L_TRIG) && (pressed & (L_JPAD | R_JPAD | D_JPAD))) {
+        replay_handle_controls(pressed);
+    }
+
+    if (gReplayState == REPLAY_STATE_RECORDING) {
+        replay_record_input(pad);
+    } else if (gReplayState == REPLAY_STATE_PLAYING && sReplayInputIndex < sReplayHeader.numInputs) {
+        replay_play_input(pad);
+    }
+}
+
+/**
+ * Starts an armed recording or playback. The RNG seed and global timer are saved when recording starts,
+ * and restored when playback starts, so that the level plays out the same way.
+ */
+void replay_level_loaded(void) {
+    if (gReplayState == REPLAY_STATE_RECORD_ARMED) {
+        sReplayHeader.globalTimer = gGlobalTimer;
+        sReplayHeader.randomSeed = random_get_seed();
+        sReplayHeader.levelNum = gCurrLevelNum;
+        sReplayHeader.numInputs = 0;
+        gReplayState = REPLAY_STATE_RECORDING;
+        append_puppyprint_log("Replay recording started.");
+    } else if (gReplayState == REPLAY_STATE_PLAYBACK_ARMED) {
+        if (gCurrLevelNum != sReplayHeader.levelNum) {
+            return;
+        }
+        gGlobalTimer = sReplayHeader.globalTimer;
+        random_set_seed(sReplayHeader.randomSeed);
+        sReplayInputIndex = 0;
+        sReplayInputFrame = 0;
+        sReplayNumFrames = 0;
+#ifdef USE_PROFILER
+        bzero(sReplayPhaseTotals, sizeof(sReplayPhaseTotals));
+#endif
+        sReplayStartTime = osGetTime();
+        gReplayState = REPLAY_STATE_PLAYING;
+        append_puppyprint_log("Replay playback started.");
+    }
+}
+
+/**
+ * Adds this frame's profiler times to the playback totals, and ends the playback once the recording runs out.
+ */
+void replay_frame_end(void) {
+    if (gReplayState != REPLAY_STATE_PLAYING) {
+        return;
+    }
+
+    sReplayNumFrames++;
+#ifdef USE_PROFILER
+    for (s32 i = 0; i < REPLAY_NUM_PHASES; i++) {
+        sReplayPhaseTotals[i] += all_profiling_data[PROFILER_TIME_CONTROLLERS + i].counts[profile_buffer_index];
+    }
+#endif
+
+    if (sReplayInputIndex >= sReplayHeader.numInputs) {
+        replay_finish_playback();
+    }
+}
+
+#endif
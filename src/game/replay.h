@@ -0,0 +1,56 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <PR/ultratypes.h>
+#include <PR/os_cont.h>
+
+#include "config.h"
+
+#ifdef INPUT_REPLAY
+
+enum ReplayStates {
+    REPLAY_STATE_IDLE,
+    REPLAY_STATE_RECORD_ARMED,
+    REPLAY_STATE_RECORDING,
+    REPLAY_STATE_PLAYBACK_ARMED,
+    REPLAY_STATE_PLAYING,
+};
+
+/**
+ * A span of frames with the same inputs.
+ */
+struct ReplayInput {
+    /*0x00*/ u16 button;
+    /*0x02*/ s8 stickX;
+    /*0x03*/ s8 stickY;
+    /*0x04*/ u8 lTrig; // The analog triggers of GameCube controllers, which game_init.c turns into Z presses.
+    /*0x05*/ u8 rTrig;
+    /*0x06*/ u8 frames;
+};
+
+/**
+ * Everything needed to repeat a recording from the level load it started on.
+ */
+struct ReplayHeader {
+    /*0x00*/ u32 globalTimer;
+    /*0x04*/ u16 randomSeed;
+    /*0x06*/ s16 levelNum;
+    /*0x08*/ u16 numInputs;
+};
+
+extern u8 gReplayState;
+extern u8 gReplayHeadless;
+
+void replay_update_inputs(OSContPadEx *pad);
+void replay_level_loaded(void);
+void replay_frame_end(void);
+
+#define replay_is_headless() (gReplayHeadless && (gReplayState == REPLAY_STATE_PLAYING))
+
+#else
+
+#define replay_is_headless() FALSE
+
+#endif
+
+#endif // REPLAY_H
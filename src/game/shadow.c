@@ -353,7 +353,7 @@ Gfx *create_shadow_below_xyz(Vec3f pos, s16 shadowScale, u8 shadowSolidity, s8 s
         }
     }
 
-    Gfx *displayList = alloc_display_list(4 * sizeof(Gfx));
+    Gfx *displayList = alloc_level_display_list(4 * sizeof(Gfx));
 
     if (displayList == NULL) {
         return NULL;
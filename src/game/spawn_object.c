@@ -5,6 +5,7 @@
 #include "engine/graph_node.h"
 #include "engine/math_util.h"
 #include "engine/surface_collision.h"
+#include "engine/surface_load.h"
 #include "level_table.h"
 #include "object_constants.h"
 #include "object_fields.h"
@@ -55,6 +56,12 @@ static void deallocate_object(struct ObjectNode *freeList, struct ObjectNode *ob
     freeList->next = obj;
 }
 
+/**
+ * The generation of each pool slot, bumped every time the slot is freed so that handles to the
+ * object it used to hold stop resolving.
+ */
+static u16 sObjectSlotGenerations[OBJECT_POOL_CAPACITY];
+
 /**
  * Add every object in the pool to the free object list.
  */
@@ -62,6 +69,16 @@ void init_free_object_list(void) {
     s32 i;
     s32 poolLength = OBJECT_POOL_CAPACITY;
 
+    // Objects still in use are dropped here without going through unload_object, so their handles
+    // have to be invalidated as well.
+    for (i = 0; i < OBJECT_POOL_CAPACITY; i++) {
+        if (gObjectSlotsUsed[i / 32] & (1U << (i % 32))) {
+            sObjectSlotGenerations[i]++;
+        }
+    }
+
+    bzero(gObjectSlotsUsed, sizeof(gObjectSlotsUsed));
+
     // Add the first object in the pool to the free list
     struct Object *obj = &gObjectPool[0];
     gFreeObjectList.next = (struct ObjectNode *) obj;
@@ -76,6 +93,34 @@ void init_free_object_list(void) {
     obj->header.next = NULL;
 }
 
+/**
+ * Get a handle to an object, which can be stored in place of a pointer and checked with obj_from_handle
+ * to find out whether the object has since been unloaded.
+ */
+ObjectHandle obj_get_handle(struct Object *obj) {
+    if (obj == NULL) {
+        return OBJECT_HANDLE_NONE;
+    }
+
+    s32 slot = (obj - gObjectPool);
+    // The slot is stored plus one so that no handle is ever OBJECT_HANDLE_NONE.
+    return (((u32) sObjectSlotGenerations[slot] << 16) | (slot + 1));
+}
+
+/**
+ * Get the object a handle refers to, or NULL if that object has been unloaded since the handle was made.
+ */
+struct Object *obj_from_handle(ObjectHandle handle) {
+    s32 slot = ((handle & 0xFFFF) - 1);
+
+    if (slot < 0 || slot >= OBJECT_POOL_CAPACITY || sObjectSlotGenerations[slot] != (handle >> 16)
+        || !(gObjectSlotsUsed[slot / 32] & (1U << (slot % 32)))) {
+        return NULL;
+    }
+
+    return &gObjectPool[slot];
+}
+
 /**
  * Clear each object list, without adding the objects back to the free list.
  */
@@ -103,6 +148,10 @@ void unload_object(struct Object *obj) {
 
     obj->header.gfx.node.flags &= ~(GRAPH_RENDER_BILLBOARD | GRAPH_RENDER_ACTIVE);
 
+    s32 slot = (obj - gObjectPool);
+    gObjectSlotsUsed[slot / 32] &= ~(1U << (slot % 32));
+    sObjectSlotGenerations[slot]++;
+
     deallocate_object(&gFreeObjectList, &obj->header);
 }
 
@@ -140,6 +189,9 @@ struct Object *allocate_object(struct ObjectNode *objList) {
         }
     }
 
+    s32 slot = (obj - gObjectPool);
+    gObjectSlotsUsed[slot / 32] |= (1U << (slot % 32));
+
     // Initialize object fields
 
     obj->activeFlags = ACTIVE_FLAG_ACTIVE | ACTIVE_FLAG_ALLOCATED;
@@ -196,6 +248,18 @@ struct Object *allocate_object(struct ObjectNode *objList) {
 #ifdef PUPPYLIGHTS
     obj->oLightID = 0xFFFF;
 #endif
+#ifdef OBJECT_FLOOR_CACHE
+    obj->floorCache.floor = NULL;
+#endif
+#ifdef INCREMENTAL_DYNAMIC_SURFACES
+    obj->dynamicSurfaceSlot = DYNAMIC_SURFACE_SLOT_NONE;
+#endif
+#ifdef OBJECT_TICK_LOD
+    obj->tickDelta = 1;
+#endif
+#ifdef MARIO_RELATIVE_CACHE
+    obj->marioRelativeCache.validFlags = 0;
+#endif
 
     return obj;
 }
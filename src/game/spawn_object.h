@@ -3,7 +3,17 @@
 
 #include "types.h"
 
+/**
+ * A reference to an object that can tell when the object has been unloaded, unlike a plain pointer
+ * which would silently start pointing at whatever object is spawned into the same slot next.
+ */
+typedef u32 ObjectHandle;
+
+#define OBJECT_HANDLE_NONE 0
+
 void init_free_object_list(void);
+ObjectHandle obj_get_handle(struct Object *obj);
+struct Object *obj_from_handle(ObjectHandle handle);
 void clear_object_lists(struct ObjectNode *objLists);
 void unload_object(struct Object *obj);
 struct Object *create_object(const BehaviorScript *bhvScript);
@@ -0,0 +1,334 @@
+#!/usr/bin/env python3
+"""
+Generates lower detail versions of a display list from a model.inc.c, by collapsing the edges
+that change the shape of the model the least (using quadric error metrics), and prints the
+geo layout nodes that switch between them by distance, along with the vertex and triangle
+counts of each level of detail.
+
+Only the triangles are decimated. Every other command of the display list (material setup,
+called display lists, etc.) is kept as is, and triangles are never merged across them, so
+each material keeps its own triangles. Vertices on the edge of a mesh or on a UV/colour seam
+are never removed, so decimated meshes don't open up holes or tear along their seams.
+
+Usage: lod_generator.py model.inc.c display_list_name [-r 0.5 0.25] [-d 1500 3000] [-o lods.inc.c]
+"""
+
+import argparse, heapq, re, sys
+
+VTX_ENTRY = re.compile(r"\{\s*\{\s*\{([^}]*)\}\s*,([^,{]*),\s*\{([^}]*)\}\s*,\s*\{([^}]*)\}\s*\}\s*\}")
+VTX_ARRAY = re.compile(r"(?:static\s+)?(?:const\s+)?Vtx\s+(\w+)\s*\[\s*\]\s*=\s*\{(.*?)\};", re.S)
+GFX_ARRAY = r"(?:static\s+)?(?:const\s+)?Gfx\s+{}\s*\[\s*\]\s*=\s*\{{(.*?)\}};"
+COMMAND = re.compile(r"(\w+)\s*\((.*)\)")
+
+def parse_int(s):
+    return int(s.strip(), 0)
+
+class Vertex:
+    def __init__(self, text, values):
+        self.text = text
+        self.pos = values[0:3]
+        # Vertices that only differ in which array they were loaded from are the same vertex.
+        self.key = tuple(values)
+
+def parse_vertex_arrays(source):
+    arrays = {}
+    for name, body in VTX_ARRAY.findall(source):
+        vertices = []
+        for match in VTX_ENTRY.finditer(body):
+            values = []
+            for group in match.groups():
+                values += [parse_int(v) for v in group.split(",") if v.strip() != ""]
+            vertices.append(Vertex(match.group(0), values))
+        arrays[name] = vertices
+    return arrays
+
+def parse_display_list(source, name, arrays):
+    """
+    Splits a display list into a list of items, which are either a command string that's kept as is,
+    or a list of triangles (each a tuple of three Vertex objects) that are drawn between two such commands.
+    """
+    match = re.search(GFX_ARRAY.format(re.escape(name)), source, re.S)
+    if match is None:
+        sys.exit(f"Display list {name} not found")
+
+    items = []
+    triangles = None
+    cache = {}
+
+    for line in match.group(1).split("\n"):
+        line = line.strip().rstrip(",")
+        if line == "" or line.startswith("//"):
+            continue
+        command = COMMAND.match(line)
+        op = command.group(1) if command else None
+        args = [a.strip() for a in command.group(2).split(",")] if command else []
+
+        if op == "gsSPVertex":
+            array, _, offset = args[0].partition("+")
+            array = array.strip().lstrip("&")
+            if array not in arrays:
+                sys.exit(f"Vertex array {array} not found")
+            offset = parse_int(offset) if offset else 0
+            for i in range(parse_int(args[1])):
+                cache[parse_int(args[2]) + i] = arrays[array][offset + i]
+        elif op in ("gsSP1Triangle", "gsSP2Triangles"):
+            if triangles is None:
+                triangles = []
+                items.append(triangles)
+            indices = [parse_int(a) for a in args]
+            triangles.append((cache[indices[0]], cache[indices[1]], cache[indices[2]]))
+            if op == "gsSP2Triangles":
+                triangles.append((cache[indices[4]], cache[indices[5]], cache[indices[6]]))
+        else:
+            triangles = None
+            items.append(line)
+
+    return items
+
+# Vector and quadric helpers. Quadrics are stored as the 10 unique entries of a symmetric 4x4 matrix.
+
+def sub(a, b):
+    return (a[0] - b[0], a[1] - b[1], a[2] - b[2])
+
+def cross(a, b):
+    return (a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0])
+
+def dot(a, b):
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]
+
+def face_normal(p0, p1, p2):
+    return cross(sub(p1, p0), sub(p2, p0))
+
+def plane_quadric(p0, p1, p2):
+    n = face_normal(p0, p1, p2)
+    area = dot(n, n) ** 0.5
+    if area == 0.0:
+        return [0.0] * 10
+    a, b, c = (n[0] / area, n[1] / area, n[2] / area)
+    d = -dot((a, b, c), p0)
+    # Weighted by area, so that big faces hold on to their shape more than small ones.
+    return [area * x for x in (a * a, a * b, a * c, a * d, b * b, b * c, b * d, c * c, c * d, d * d)]
+
+def quadric_error(q, p):
+    x, y, z = p
+    return (q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x
+            + q[4] * y * y + 2 * q[5] * y * z + 2 * q[6] * y
+            + q[7] * z * z + 2 * q[8] * z + q[9])
+
+def decimate(triangles, ratio):
+    """
+    Collapses edges of a list of triangles until only 'ratio' of them are left, or nothing else can
+    be collapsed without removing a seam vertex or flipping a triangle. Each collapse moves one vertex
+    onto a neighbouring one, so every vertex of the result is one of the original ones.
+    """
+    target = max(1, int(round(len(triangles) * ratio)))
+    if target >= len(triangles):
+        return list(triangles)
+
+    # Weld the vertices that are loaded more than once.
+    ids = {}
+    verts = []
+    tris = []
+    for tri in triangles:
+        face = []
+        for v in tri:
+            if v.key not in ids:
+                ids[v.key] = len(verts)
+                verts.append(v)
+            face.append(ids[v.key])
+        tris.append(face)
+
+    alive = [True] * len(tris)
+    numAlive = len(tris)
+    vertTris = [set() for _ in verts]
+    quadrics = [[0.0] * 10 for _ in verts]
+    edgeUses = {}
+    for t, face in enumerate(tris):
+        q = plane_quadric(*(verts[i].pos for i in face))
+        for i in range(3):
+            vertTris[face[i]].add(t)
+            quadrics[face[i]] = [a + b for a, b in zip(quadrics[face[i]], q)]
+            edge = tuple(sorted((face[i], face[(i + 1) % 3])))
+            edgeUses[edge] = edgeUses.get(edge, 0) + 1
+
+    locked = [False] * len(verts)
+    for (a, b), uses in edgeUses.items():
+        if uses != 2:
+            locked[a] = locked[b] = True
+
+    def neighbours(v):
+        return {i for t in vertTris[v] for i in tris[t]} - {v}
+
+    version = [0] * len(verts)
+    heap = []
+
+    def push(v, u):
+        if not locked[v]:
+            q = [a + b for a, b in zip(quadrics[u], quadrics[v])]
+            heapq.heappush(heap, (quadric_error(q, verts[u].pos), version[v], version[u], v, u))
+
+    for (a, b) in edgeUses:
+        push(a, b)
+        push(b, a)
+
+    while numAlive > target and heap:
+        _, versionV, versionU, v, u = heapq.heappop(heap)
+        if versionV != version[v] or versionU != version[u] or u not in neighbours(v):
+            continue
+
+        # Only collapse edges that two triangles share, so the mesh stays manifold.
+        if len(neighbours(u) & neighbours(v)) != 2:
+            continue
+
+        shared = [t for t in vertTris[v] if u in tris[t]]
+        moved = [t for t in vertTris[v] if u not in tris[t]]
+        flipped = False
+        for t in moved:
+            old = [verts[i].pos for i in tris[t]]
+            new = [verts[u].pos if i == v else verts[i].pos for i in tris[t]]
+            oldNormal = face_normal(*old)
+            newNormal = face_normal(*new)
+            if dot(newNormal, newNormal) == 0.0 or dot(oldNormal, newNormal) <= 0.0:
+                flipped = True
+                break
+        if flipped:
+            continue
+
+        for t in shared:
+            alive[t] = False
+            numAlive -= 1
+            for i in tris[t]:
+                vertTris[i].discard(t)
+        for t in moved:
+            tris[t] = [u if i == v else i for i in tris[t]]
+            vertTris[u].add(t)
+        vertTris[v] = set()
+        quadrics[u] = [a + b for a, b in zip(quadrics[u], quadrics[v])]
+
+        version[v] += 1
+        version[u] += 1
+        for n in neighbours(u):
+            version[n] += 1
+        for n in neighbours(u):
+            for m in neighbours(n):
+                push(n, m)
+                push(m, n)
+
+    return [tuple(verts[i] for i in tris[t]) for t in range(len(tris)) if alive[t]]
+
+def emit_display_list(name, items, cacheSize):
+    """
+    Returns the C source of the vertex arrays and display list for a list of items,
+    along with its number of vertices, triangles and vertex loads.
+    """
+    arrays = []
+    lines = []
+    stats = [0, 0, 0]
+
+    def flush(batch, batchTris):
+        if len(batch) == 0:
+            return
+        arrayName = f"{name}_vertex_{len(arrays)}"
+        arrays.append(f"static const Vtx {arrayName}[] = {{\n"
+                      + "".join(f"    {v.text},\n" for v in batch)
+                      + "};\n")
+        lines.append(f"    gsSPVertex({arrayName}, {len(batch)}, 0),")
+        for i in range(0, len(batchTris) - 1, 2):
+            a, b = batchTris[i], batchTris[i + 1]
+            lines.append(f"    gsSP2Triangles({a[0]:2}, {a[1]:2}, {a[2]:2}, 0x0, {b[0]:2}, {b[1]:2}, {b[2]:2}, 0x0),")
+        if len(batchTris) % 2 != 0:
+            a = batchTris[-1]
+            lines.append(f"    gsSP1Triangle({a[0]:2}, {a[1]:2}, {a[2]:2}, 0x0),")
+        stats[0] += len(batch)
+        stats[1] += len(batchTris)
+        stats[2] += 1
+
+    for item in items:
+        if isinstance(item, str):
+            lines.append(f"    {item},")
+            continue
+
+        batch = []
+        slots = {}
+        batchTris = []
+        for tri in item:
+            new = {v.key for v in tri if v.key not in slots}
+            if len(batch) + len(new) > cacheSize:
+                flush(batch, batchTris)
+                batch = []
+                slots = {}
+                batchTris = []
+            face = []
+            for v in tri:
+                if v.key not in slots:
+                    slots[v.key] = len(batch)
+                    batch.append(v)
+                face.append(slots[v.key])
+            batchTris.append(face)
+        flush(batch, batchTris)
+
+    source = "".join(arrays) + f"\nconst Gfx {name}[] = {{\n" + "\n".join(lines) + "\n};\n"
+    return source, stats
+
+def main():
+    parser = argparse.ArgumentParser(description="Generates decimated levels of detail for a display list in a model.inc.c.")
+    parser.add_argument("model", help="model.inc.c to read the display list and its vertices from")
+    parser.add_argument("displayList", help="name of the display list to decimate")
+    parser.add_argument("-r", "--ratios", type=float, nargs="+", default=[0.5, 0.25],
+                        help="fraction of the triangles each level of detail keeps (default: 0.5 0.25)")
+    parser.add_argument("-d", "--distances", type=int, nargs="+", default=None,
+                        help="camera distance at which each level of detail starts being used (default: 1500 per level)")
+    parser.add_argument("-l", "--layer", default="LAYER_OPAQUE", help="layer for the generated geo layout nodes (default: LAYER_OPAQUE)")
+    parser.add_argument("-c", "--cache-size", type=int, default=32, help="size of the microcode's vertex buffer (default: 32)")
+    parser.add_argument("-o", "--output", help="file to write the generated display lists to (default: stdout)")
+    args = parser.parse_args()
+
+    distances = args.distances or [1500 * (i + 1) for i in range(len(args.ratios))]
+    if len(distances) != len(args.ratios):
+        sys.exit("There must be one distance per ratio")
+
+    with open(args.model, "r") as f:
+        source = f.read()
+
+    arrays = parse_vertex_arrays(source)
+    items = parse_display_list(source, args.displayList, arrays)
+
+    # Vertices are counted as they're loaded, since that's what the RSP has to transform.
+    report = []
+    _, stats = emit_display_list(args.displayList, items, args.cache_size)
+    report.append((args.displayList, stats[0], stats[1], stats[2]))
+
+    output = ""
+    names = [args.displayList]
+    for i, ratio in enumerate(args.ratios):
+        name = f"{args.displayList}_lod{i + 1}"
+        lod = [item if isinstance(item, str) else decimate(item, ratio) for item in items]
+        text, stats = emit_display_list(name, lod, args.cache_size)
+        output += f"// Generated by tools/lod_generator.py from {args.displayList}, keeping {ratio:g} of its triangles.\n" + text + "\n"
+        names.append(name)
+        report.append((name, stats[0], stats[1], stats[2]))
+
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(output)
+    else:
+        print(output)
+
+    ranges = [-2048] + distances + [32767]
+    geo = []
+    for i, name in enumerate(names):
+        geo.append(f"GEO_RENDER_RANGE({ranges[i]}, {ranges[i + 1]}),")
+        geo.append("GEO_OPEN_NODE(),")
+        geo.append(f"   GEO_DISPLAY_LIST({args.layer}, {name}),")
+        geo.append("GEO_CLOSE_NODE(),")
+
+    out = sys.stderr if not args.output else sys.stdout
+    print("Geo layout nodes (replace the display list's own node with these):", file=out)
+    print("\n".join("   " + line for line in geo), file=out)
+    print("", file=out)
+    print(f"{'Display list':40} {'Vertices':>8} {'Triangles':>9} {'Loads':>5}", file=out)
+    for name, verts, tris, loads in report:
+        print(f"{name:40} {verts:8} {tris:9} {loads:5}", file=out)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,287 @@
+#!/usr/bin/env python3
+"""
+Precomputes which rooms of an area can be seen from each other, from the area's collision.inc.c
+and room.inc.c, and prints the table to pass to the ROOM_VISIBILITY level command.
+
+Every collision triangle belongs to the room at the same index of the RoomData array. Viewpoints
+are sampled anywhere between Mario's eye height and the camera's height above the floors of each
+room, and targets on every surface of the other rooms, with at least one of each per triangle so
+that small surfaces around doorways aren't missed. A room can see another if any ray between them
+isn't blocked by a collision triangle. Visibility is always symmetric, and every room can see itself.
+
+The table has to be conservative, since a room that's wrongly hidden pops in and out of view, so
+only surfaces that are certain to be drawn block rays. Intangible, camera and warp triangles and
+invisible walls are skipped, as are doors and other objects, which aren't part of the level
+collision, so rooms are always treated as visible through doorways.
+
+Usage: room_pvs.py collision.inc.c room.inc.c [-n name] [-s samples] [-o visibility.inc.c]
+"""
+
+import argparse, math, random, re, sys
+
+# Highest room a RoomVisibility bitfield can hold.
+MAX_ROOM = 63
+# Mario's eye height above the floor, the lowest viewpoint.
+EYE_HEIGHT = 160.0
+# How high above the floor the camera can be, the highest viewpoint.
+CAMERA_HEIGHT = 600.0
+# How far targets are pushed out of their surface, so they aren't hidden by the surface itself.
+SURFACE_OFFSET = 8.0
+# Same as NORMAL_FLOOR_THRESHOLD.
+FLOOR_THRESHOLD = 0.01
+EPSILON = 1e-6
+
+# Surface types that aren't drawn, or can be seen or walked through, so they never block a ray.
+NON_OCCLUDING_TYPES = {
+    "SURFACE_INTANGIBLE",
+    "SURFACE_CAMERA_BOUNDARY",
+    "SURFACE_WALL_MISC",
+    "SURFACE_VANISH_CAP_WALLS",
+    "SURFACE_TRAPDOOR",
+    "SURFACE_DEATH_PLANE",
+    "SURFACE_VERTICAL_WIND",
+    "SURFACE_WARP",
+    "SURFACE_LOOK_UP_WARP",
+    "SURFACE_WOBBLING_WARP",
+}
+NON_OCCLUDING_PREFIXES = ("SURFACE_NO_CAM_", "SURFACE_INSTANT_WARP_", "SURFACE_PAINTING_")
+
+COMMAND = re.compile(r"(COL_\w+)\s*\(([^)]*)\)")
+ROOM_ARRAY = re.compile(r"RoomData\s+\w+\s*\[\s*\]\s*=\s*\{(.*?)\};", re.S)
+
+def strip_comments(source):
+    return re.sub(r"//[^\n]*|/\*.*?\*/", "", source, flags=re.S)
+
+def is_occluder(surfaceType):
+    return surfaceType not in NON_OCCLUDING_TYPES and not surfaceType.startswith(NON_OCCLUDING_PREFIXES)
+
+def parse_collision(source):
+    vertices, triangles = [], []
+    occluder = True
+
+    for command, args in COMMAND.findall(strip_comments(source)):
+        values = [a.strip() for a in args.split(",") if a.strip() != ""]
+        if command == "COL_VERTEX":
+            vertices.append(tuple(float(int(v, 0)) for v in values))
+        elif command == "COL_TRI_INIT":
+            occluder = is_occluder(values[0])
+        elif command in ("COL_TRI", "COL_TRI_SPECIAL"):
+            triangles.append((tuple(int(v, 0) for v in values[0:3]), occluder))
+        elif command in ("COL_TRI_STOP", "COL_END"):
+            break
+
+    return vertices, triangles
+
+def parse_rooms(source):
+    match = ROOM_ARRAY.search(strip_comments(source))
+    if match is None:
+        sys.exit("error: no RoomData array found")
+    return [int(v, 0) for v in match.group(1).split(",") if v.strip() != ""]
+
+def sub(a, b):
+    return (a[0] - b[0], a[1] - b[1], a[2] - b[2])
+
+def cross(a, b):
+    return (a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0])
+
+def dot(a, b):
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]
+
+class Triangle:
+    def __init__(self, index, v1, v2, v3, room, occluder):
+        self.index = index
+        self.occluder = occluder
+        self.v1 = v1
+        self.e1 = sub(v2, v1)
+        self.e2 = sub(v3, v1)
+        self.room = room
+        n = cross(self.e1, self.e2)
+        length = math.sqrt(dot(n, n))
+        self.area = length / 2
+        self.normal = (n[0] / length, n[1] / length, n[2] / length) if length > 0 else (0.0, 0.0, 0.0)
+        self.min = tuple(min(v1[a], v2[a], v3[a]) for a in range(3))
+        self.max = tuple(max(v1[a], v2[a], v3[a]) for a in range(3))
+
+    def sample(self, rng):
+        # Uniform point on the triangle.
+        r1, r2 = rng.random(), rng.random()
+        if r1 + r2 > 1:
+            r1, r2 = 1 - r1, 1 - r2
+        return tuple(self.v1[a] + self.e1[a] * r1 + self.e2[a] * r2 for a in range(3))
+
+    def intersect(self, orig, dir):
+        # Moller-Trumbore, two sided. Returns the distance along 'dir' (in units of its length), or None.
+        p = cross(dir, self.e2)
+        det = dot(self.e1, p)
+        if abs(det) < EPSILON:
+            return None
+        inv = 1.0 / det
+        t = sub(orig, self.v1)
+        u = dot(t, p) * inv
+        if u < 0 or u > 1:
+            return None
+        q = cross(t, self.e1)
+        v = dot(dir, q) * inv
+        if v < 0 or u + v > 1:
+            return None
+        return dot(self.e2, q) * inv
+
+class Grid:
+    """Uniform grid over the triangles that block rays, walked cell by cell along each ray."""
+
+    def __init__(self, triangles):
+        triangles = [t for t in triangles if t.occluder]
+        self.min = [min(t.min[a] for t in triangles) - 1 for a in range(3)]
+        extent = [max(t.max[a] for t in triangles) + 1 - self.min[a] for a in range(3)]
+        volume = extent[0] * extent[1] * extent[2]
+        self.size = max((volume / (len(triangles) * 2)) ** (1 / 3), 64.0)
+        self.dims = [max(1, int(math.ceil(e / self.size))) for e in extent]
+        self.cells = {}
+
+        for tri in triangles:
+            lo = [self.cell(tri.min[a], a) for a in range(3)]
+            hi = [self.cell(tri.max[a], a) for a in range(3)]
+            for x in range(lo[0], hi[0] + 1):
+                for y in range(lo[1], hi[1] + 1):
+                    for z in range(lo[2], hi[2] + 1):
+                        self.cells.setdefault((x, y, z), []).append(tri)
+
+    def cell(self, value, axis):
+        return min(max(int((value - self.min[axis]) // self.size), 0), self.dims[axis] - 1)
+
+    def blocked(self, start, end):
+        # Returns whether any triangle lies strictly between the two points.
+        dir = sub(end, start)
+        cell = [self.cell(start[a], a) for a in range(3)]
+        last = [self.cell(end[a], a) for a in range(3)]
+        step, tNext, tDelta = [0] * 3, [math.inf] * 3, [math.inf] * 3
+
+        for a in range(3):
+            if dir[a] > 0:
+                step[a] = 1
+                tNext[a] = (self.min[a] + (cell[a] + 1) * self.size - start[a]) / dir[a]
+                tDelta[a] = self.size / dir[a]
+            elif dir[a] < 0:
+                step[a] = -1
+                tNext[a] = (self.min[a] + cell[a] * self.size - start[a]) / dir[a]
+                tDelta[a] = -self.size / dir[a]
+
+        tested = set()
+        while True:
+            for tri in self.cells.get(tuple(cell), ()):
+                if tri.index in tested:
+                    continue
+                tested.add(tri.index)
+                t = tri.intersect(start, dir)
+                if t is not None and EPSILON < t < 1 - EPSILON:
+                    return True
+
+            if cell == last:
+                return False
+            axis = min(range(3), key=lambda a: tNext[a])
+            if tNext[axis] > 1:
+                return False
+            cell[axis] += step[axis]
+            tNext[axis] += tDelta[axis]
+
+def sample_triangles(triangles, count, rng):
+    # One sample on every triangle, then the rest weighted by surface area, so big floors and walls
+    # get most of the points without small ones being skipped.
+    triangles = [t for t in triangles if t.area > 0]
+    if not triangles:
+        return []
+    extra = max(count - len(triangles), 0)
+    return triangles + rng.choices(triangles, [t.area for t in triangles], k=extra)
+
+def sample_viewpoints(grid, floors, count, rng):
+    points = []
+    for tri in sample_triangles(floors, count, rng):
+        p = tri.sample(rng)
+        eye = (p[0], p[1] + EYE_HEIGHT, p[2])
+        # Anywhere the camera can be, as long as it's still below the ceiling.
+        camera = (p[0], p[1] + rng.uniform(EYE_HEIGHT, CAMERA_HEIGHT), p[2])
+        points.append(eye if grid.blocked(eye, camera) else camera)
+    return points
+
+def sample_targets(triangles, count, rng):
+    points = []
+    for tri in sample_triangles(triangles, count, rng):
+        p = tri.sample(rng)
+        points.append(tuple(p[a] + tri.normal[a] * SURFACE_OFFSET for a in range(3)))
+    return points
+
+def rooms_see_each_other(grid, viewpoints, targets, rng, samples):
+    # Stratified over the viewpoints, so that every one of them is tried before any is tried twice.
+    order = list(range(len(viewpoints)))
+    rng.shuffle(order)
+    for i in range(samples):
+        if not grid.blocked(viewpoints[order[i % len(order)]], rng.choice(targets)):
+            return True
+    return False
+
+def main():
+    parser = argparse.ArgumentParser(description="Precomputes room to room visibility for ROOM_VISIBILITY.")
+    parser.add_argument("collision", help="collision.inc.c of the area")
+    parser.add_argument("rooms", help="room.inc.c of the area")
+    parser.add_argument("-n", "--name", help="name of the generated table (defaults to the RoomData array's name with _visibility)")
+    parser.add_argument("-s", "--samples", type=int, default=4096, help="rays tried between each pair of rooms")
+    parser.add_argument("-o", "--output", help="file to write the table to, instead of stdout")
+    args = parser.parse_args()
+
+    with open(args.collision) as f:
+        vertices, indices = parse_collision(f.read())
+    with open(args.rooms) as f:
+        roomSource = f.read()
+    rooms = parse_rooms(roomSource)
+
+    if len(rooms) != len(indices):
+        sys.exit("error: %d collision triangles but %d room entries" % (len(indices), len(rooms)))
+    if max(rooms) > MAX_ROOM:
+        sys.exit("error: room %d is higher than the maximum of %d" % (max(rooms), MAX_ROOM))
+
+    triangles = [Triangle(i, vertices[a], vertices[b], vertices[c], rooms[i], occluder)
+                 for i, ((a, b, c), occluder) in enumerate(indices)]
+    grid = Grid(triangles)
+    numRooms = max(rooms) + 1
+    rng = random.Random(0)
+
+    viewpoints, targets = {}, {}
+    for room in range(1, numRooms):
+        roomTris = [t for t in triangles if t.room == room]
+        viewpoints[room] = sample_viewpoints(grid, [t for t in roomTris if t.normal[1] > FLOOR_THRESHOLD], args.samples, rng)
+        targets[room] = sample_targets(roomTris, args.samples, rng)
+
+    visible = {room: {room} for room in range(1, numRooms)}
+    for a in range(1, numRooms):
+        for b in range(a + 1, numRooms):
+            # Rooms without floors can't be stood in, so can always be seen from the other room.
+            if ((targets[a] and targets[b])
+                and not (viewpoints[a] and rooms_see_each_other(grid, viewpoints[a], targets[b], rng, args.samples))
+                and not (viewpoints[b] and rooms_see_each_other(grid, viewpoints[b], targets[a], rng, args.samples))):
+                continue
+            visible[a].add(b)
+            visible[b].add(a)
+
+    if args.name is None:
+        args.name = re.search(r"RoomData\s+(\w+)", roomSource).group(1) + "_visibility"
+
+    lines = ["// Generated by room_pvs.py from %s." % args.collision,
+             "const RoomVisibility %s[] = {" % args.name,
+             "    %d, // Number of entries" % numRooms]
+    for room in range(1, numRooms):
+        bits = sum(1 << r for r in visible[room])
+        lines.append("    0x%016XULL, // Room %d" % (bits, room))
+    lines.append("};")
+
+    output = "\n".join(lines) + "\n"
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(output)
+    else:
+        sys.stdout.write(output)
+
+    for room in range(1, numRooms):
+        print("room %2d: %2d/%d rooms visible" % (room, len(visible[room]), numRooms - 1), file=sys.stderr)
+
+if __name__ == "__main__":
+    main()